@@ -0,0 +1,201 @@
+/**
+ * @file BufferDeTramas.h
+ * @brief Buffer de tramas en arreglos paralelos (parsear y luego ejecutar)
+ * 
+ * Motor por lotes: primero convierte un bloque completo de texto en dos
+ * arreglos compactos (etiquetas y cargas) y después los ejecuta en un
+ * solo ciclo con despacho estático (switch), sin crear objetos Trama.
+ * El camino polimórfico (TramaBase::procesar) sigue disponible para
+ * tipos de trama propios.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef BUFFERDETRAMAS_H
+#define BUFFERDETRAMAS_H
+
+#include <cstddef>
+
+class ListaDeCarga;
+class RotorDeMapeo;
+class CascadaDeRotores;
+
+/**
+ * @class BufferDeTramas
+ * @brief Arreglo de tramas ya parseadas (estructura de arreglos)
+ * 
+ * La trama i está dada por etiquetas[i] y cargas[i]:
+ * - CARGA:       cargas[i] es el carácter (L,X)
+ * - MAPEO:       cargas[i] es la rotación (M,N o M0,N)
+ * - MAPEO_ROTOR: trama Mk,N con k > 0; cargas[i] es k * 27 más la
+ *                rotación reducida a 0..26 (ver getIndiceRotor/getRotacion)
+ * - REINICIO:    marcador "REINICIANDO SECUENCIA" (carga sin uso)
+ * 
+ * Las tramas Mk,N con k fuera de 0 .. numRotores-1 se descartan como
+ * mal formadas, igual que ROTOR_INEXISTENTE en SesionPRT7.
+ */
+class BufferDeTramas {
+public:
+    /**
+     * @brief Tipo de cada trama del buffer
+     */
+    enum Etiqueta {
+        CARGA = 0,       ///< Trama L,X
+        MAPEO = 1,       ///< Trama M,N (rotor 0)
+        REINICIO = 2,    ///< Marcador de reinicio de secuencia
+        MAPEO_ROTOR = 3  ///< Trama Mk,N con k > 0 (solo con varios rotores)
+    };
+    
+    /**
+     * @brief Función llamada al terminar cada secuencia durante ejecutar()
+     * @param carga Lista con el mensaje de la secuencia terminada
+     * @param contexto Puntero de usuario pasado a ejecutar()
+     */
+    typedef void (*FinDeSecuencia)(const ListaDeCarga* carga, void* contexto);
+    
+private:
+    static const int MAX_LINEA = 256;  ///< Longitud máxima de una línea
+    
+    unsigned char* etiquetas;  ///< Etiqueta de cada trama
+    int* cargas;               ///< Carga de cada trama
+    int numTramas;             ///< Número de tramas almacenadas
+    int capacidad;             ///< Capacidad de los arreglos
+    int errores;               ///< Tramas mal formadas descartadas
+    int numRotores;            ///< Rotores que aceptan las tramas Mk,N
+    
+    char pendiente[MAX_LINEA]; ///< Línea incompleta al final del último bloque
+    int longPendiente;         ///< Longitud de la línea pendiente
+    
+    /**
+     * @brief Agrega una trama, duplicando la capacidad si es necesario
+     */
+    void agregar(unsigned char etiqueta, int carga);
+    
+    /**
+     * @brief Parsea una línea completa (sin salto de línea)
+     */
+    void agregarLinea(const char* linea, int longitud);
+    
+    // No copiable: es dueño de los arreglos
+    BufferDeTramas(const BufferDeTramas&);
+    BufferDeTramas& operator=(const BufferDeTramas&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param capacidadInicial Número de tramas reservadas al inicio
+     * @param rotores Número de rotores (1 = protocolo original; se usa al menos 1)
+     */
+    explicit BufferDeTramas(int capacidadInicial = 1024, int rotores = 1);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Libera los arreglos.
+     */
+    ~BufferDeTramas();
+    
+    /**
+     * @brief Parsea un bloque de texto y agrega sus tramas al buffer
+     * 
+     * El bloque puede terminar a mitad de una línea: el resto se guarda
+     * y se completa con el siguiente bloque (o con finalizar()).
+     * Las líneas que no son tramas (separadores, etc.) se ignoran.
+     * 
+     * @param bloque Texto con una o más líneas
+     * @param longitud Número de bytes del bloque
+     * @return Número de tramas agregadas
+     */
+    int parsearBloque(const char* bloque, std::size_t longitud);
+    
+    /**
+     * @brief Parsea la línea pendiente (si existe) aunque no tenga salto de línea
+     * @return Número de tramas agregadas (0 o 1)
+     */
+    int finalizar();
+    
+    /**
+     * @brief Ejecuta todas las tramas del buffer
+     * 
+     * Despacho estático por etiqueta. Las tramas MAP consecutivas se
+     * fusionan en una sola rotación, y cada racha de tramas LOAD usa una
+     * tabla de mapeo memorizada (el rotor no cambia dentro de la racha).
+     * En cada REINICIO llama a fin (si no es nullptr y hay mensaje),
+     * vacía la lista y reinicia el rotor.
+     * 
+     * Con un solo rotor no hay tramas MAPEO_ROTOR (se descartan al parsear).
+     * 
+     * @param carga Lista donde se insertan los caracteres decodificados
+     * @param rotor Rotor de mapeo
+     * @param fin Función llamada al terminar cada secuencia (opcional)
+     * @param contexto Puntero de usuario para fin
+     * @return Número de tramas ejecutadas
+     */
+    int ejecutar(ListaDeCarga* carga, RotorDeMapeo* rotor,
+                 FinDeSecuencia fin = nullptr, void* contexto = nullptr) const;
+    
+    /**
+     * @brief Ejecuta todas las tramas del buffer sobre una cascada de rotores
+     * 
+     * Igual que la versión de un rotor: cada MAPEO rota el rotor 0 y cada
+     * MAPEO_ROTOR el rotor de su trama; la cascada recalcula su tabla
+     * compuesta una vez por racha de tramas MAP. En cada REINICIO todos
+     * los rotores vuelven a 'A'.
+     * 
+     * @param carga Lista donde se insertan los caracteres decodificados
+     * @param cascada Cascada con al menos los rotores del constructor
+     * @param fin Función llamada al terminar cada secuencia (opcional)
+     * @param contexto Puntero de usuario para fin
+     * @return Número de tramas ejecutadas
+     */
+    int ejecutar(ListaDeCarga* carga, CascadaDeRotores* cascada,
+                 FinDeSecuencia fin = nullptr, void* contexto = nullptr) const;
+    
+    /**
+     * @brief Elimina todas las tramas (conserva la capacidad)
+     * 
+     * La línea incompleta pendiente se conserva, así que el buffer se
+     * puede limpiar después de cada ejecutar() en una lectura por partes.
+     */
+    void limpiar();
+    
+    /**
+     * @brief Obtiene el número de tramas almacenadas
+     */
+    int obtenerNumTramas() const;
+    
+    /**
+     * @brief Obtiene el número de tramas mal formadas descartadas
+     */
+    int obtenerErrores() const;
+    
+    /**
+     * @brief Obtiene la etiqueta de la trama i
+     */
+    Etiqueta getEtiqueta(int i) const;
+    
+    /**
+     * @brief Obtiene la carga de la trama i
+     */
+    int getCarga(int i) const;
+    
+    /**
+     * @brief Obtiene el rotor de una trama MAPEO o MAPEO_ROTOR
+     */
+    int getIndiceRotor(int i) const;
+    
+    /**
+     * @brief Obtiene la rotación de una trama MAPEO o MAPEO_ROTOR
+     * 
+     * En MAPEO_ROTOR es la rotación ya reducida a 0..26.
+     */
+    int getRotacion(int i) const;
+    
+    /**
+     * @brief Obtiene el número de rotores que acepta el buffer
+     */
+    int obtenerNumRotores() const;
+};
+
+#endif // BUFFERDETRAMAS_H
@@ -0,0 +1,102 @@
+/**
+ * @file CascadaDeRotores.h
+ * @brief Cascada de varios rotores con tabla de mapeo compuesta
+ * 
+ * Encadena N rotores de mapeo: la salida de cada rotor es la entrada
+ * del siguiente. Para que decodificar siga siendo una sola consulta,
+ * mantiene una tabla de 27 entradas con el mapeo compuesto que solo se
+ * recalcula cuando algún rotor se mueve.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef CASCADADEROTORES_H
+#define CASCADADEROTORES_H
+
+class RotorDeMapeo;
+
+/**
+ * @class CascadaDeRotores
+ * @brief Motor de decodificación con varios rotores encadenados
+ * 
+ * Cada rotor se direcciona por su índice (tramas M0,N  M1,N ...).
+ * El rotor 0 es el primero que se aplica al carácter de entrada.
+ */
+class CascadaDeRotores {
+private:
+    static const int TAM_ALFABETO = 27;  ///< A-Z más espacio
+    
+    RotorDeMapeo** rotores;              ///< Arreglo dinámico de rotores
+    int numRotores;                      ///< Número de rotores en la cascada
+    mutable char tabla[TAM_ALFABETO];    ///< Mapeo compuesto (índice 26 = espacio)
+    mutable bool tablaValida;            ///< false si algún rotor se movió
+    
+    /**
+     * @brief Recalcula la tabla compuesta pasando cada símbolo por todos los rotores
+     */
+    void recalcularTabla() const;
+    
+    // No copiable: es dueña de los rotores
+    CascadaDeRotores(const CascadaDeRotores&);
+    CascadaDeRotores& operator=(const CascadaDeRotores&);
+    
+public:
+    /**
+     * @brief Constructor
+     * 
+     * Crea n rotores, todos con la cabeza en 'A'.
+     * 
+     * @param n Número de rotores (mínimo 1)
+     */
+    explicit CascadaDeRotores(int n);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Libera todos los rotores.
+     */
+    ~CascadaDeRotores();
+    
+    /**
+     * @brief Rota un rotor de la cascada
+     * 
+     * Invalida la tabla compuesta; se recalcula en la siguiente consulta,
+     * de modo que varias rotaciones seguidas cuestan un solo recálculo.
+     * 
+     * @param indice Índice del rotor (0 .. numRotores-1)
+     * @param n Número de posiciones a rotar
+     * @return true si el índice es válido, false en caso contrario
+     */
+    bool rotar(int indice, int n);
+    
+    /**
+     * @brief Vuelve todos los rotores a 'A' (inicio de una secuencia)
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Obtiene el carácter mapeado por toda la cascada
+     * 
+     * Una sola consulta a la tabla compuesta, sin importar el número de rotores.
+     * 
+     * @param in Carácter de entrada
+     * @return Carácter mapeado (los caracteres fuera del alfabeto no cambian)
+     */
+    char getMapeo(char in) const;
+    
+    /**
+     * @brief Obtiene un rotor de la cascada
+     * @param indice Índice del rotor
+     * @return Puntero al rotor, nullptr si el índice no es válido
+     */
+    const RotorDeMapeo* getRotor(int indice) const;
+    
+    /**
+     * @brief Obtiene el número de rotores
+     * @return Número de rotores en la cascada
+     */
+    int obtenerNumRotores() const;
+};
+
+#endif // CASCADADEROTORES_H
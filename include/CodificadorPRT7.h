@@ -0,0 +1,136 @@
+/**
+ * @file CodificadorPRT7.h
+ * @brief Codificador PRT-7: genera tramas LOAD/MAP a partir de texto plano
+ * 
+ * Es la operación inversa de RotorDeMapeo::getMapeo. Un planificador
+ * elige las rotaciones (tramas MAP) con programación dinámica sobre los
+ * 27 desplazamientos posibles del rotor, minimizando el número de tramas
+ * o de bytes, o forzando una densidad de tramas MAP para pruebas de carga.
+ * 
+ * La planificación es exacta pero recorre los 27 estados en cada
+ * carácter: unos pocos MB/s. Minimizando tramas sin MAPs forzados el
+ * plan óptimo es no rotar nunca y se emite directo (decenas de MB/s o
+ * más), por eso es el objetivo por defecto.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef CODIFICADORPRT7_H
+#define CODIFICADORPRT7_H
+
+#include <cstddef>
+
+/**
+ * @class CodificadorPRT7
+ * @brief Convierte texto plano en un flujo de tramas PRT-7 válido
+ * 
+ * Con el rotor en el desplazamiento p (cabeza en el símbolo p de
+ * "A..Z "), la letra x se decodifica como el símbolo (x + p) mod 27 y
+ * el espacio siempre como espacio. Por eso:
+ * - una letra y se envía como la letra (y - p) mod 27, salvo que ese
+ *   valor sea 26 (la letra p-1 no se puede producir con ese desplazamiento);
+ * - un espacio se envía como "L,Space" o, si p != 0, como la letra 26 - p
+ *   (trama más corta).
+ * 
+ * Las minúsculas se codifican como mayúsculas (el decodificador siempre
+ * produce mayúsculas). Otros caracteres se envían tal cual.
+ */
+class CodificadorPRT7 {
+public:
+    /**
+     * @brief Criterio del planificador
+     */
+    enum Objetivo {
+        MINIMO_TRAMAS,  ///< Primero el menor número de tramas, después de bytes
+        MINIMO_BYTES    ///< Primero el menor número de bytes, después de tramas (más lento)
+    };
+    
+private:
+    static const int TAM_ALFABETO = 27;   ///< A-Z más espacio
+    static const int ROTACION_CORTA = 9;  ///< Avances con la trama MAP más corta ("M,1".."M,9")
+    static const std::size_t BLOQUE = 65536;  ///< Caracteres planificados a la vez
+    
+    Objetivo objetivo;       ///< Criterio del planificador
+    int cargasPorMap;        ///< Forzar un MAP cada N cargas (0 = sin forzar)
+    int desplazamiento;      ///< Desplazamiento actual del rotor del receptor
+    int cargasDesdeMap;      ///< Cargas emitidas desde el último MAP
+    
+    char* salida;            ///< Tramas generadas
+    std::size_t longSalida;  ///< Bytes en salida
+    std::size_t capSalida;   ///< Capacidad de salida
+    
+    unsigned long long tramasLoad;  ///< Tramas LOAD emitidas
+    unsigned long long tramasMap;   ///< Tramas MAP emitidas
+    
+    unsigned char* origen;   ///< Decisiones de la planificación [i * 27 + q]
+    
+    int costoMap[2 * TAM_ALFABETO];       ///< Costo ponderado de rotar (delta + 27) posiciones, duplicado
+    int costoCarga[28][TAM_ALFABETO];     ///< Costo ponderado de cargar [símbolo + 1][p]
+    
+    void reservar(std::size_t extra);
+    void emitirTexto(const char* texto, std::size_t n);
+    void emitirCarga(char c);
+    void emitirMap(int n);
+    void codificarBloque(const char* texto, std::size_t n);
+    
+    // No copiable
+    CodificadorPRT7(const CodificadorPRT7&);
+    CodificadorPRT7& operator=(const CodificadorPRT7&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param obj Criterio del planificador
+     * @param mapCadaN Forzar una trama MAP cada N tramas LOAD (0 = sin forzar)
+     */
+    explicit CodificadorPRT7(Objetivo obj = MINIMO_TRAMAS, int mapCadaN = 0);
+    
+    /**
+     * @brief Destructor
+     */
+    ~CodificadorPRT7();
+    
+    /**
+     * @brief Codifica texto y agrega las tramas a la salida
+     * 
+     * Cada '\\n' del texto cierra la secuencia (línea "--- REINICIANDO
+     * SECUENCIA ---", el rotor del receptor vuelve a 'A'); los '\\r' se ignoran.
+     * 
+     * @param texto Texto plano
+     * @param n Número de bytes
+     */
+    void codificar(const char* texto, std::size_t n);
+    
+    /**
+     * @brief Emite el marcador de reinicio de secuencia
+     */
+    void agregarReinicio();
+    
+    /**
+     * @brief Obtiene las tramas generadas (no terminadas en '\\0')
+     */
+    const char* obtenerSalida() const;
+    
+    /**
+     * @brief Obtiene el número de bytes generados
+     */
+    std::size_t obtenerLongitud() const;
+    
+    /**
+     * @brief Descarta la salida ya consumida (conserva el estado del rotor)
+     */
+    void limpiarSalida();
+    
+    /**
+     * @brief Obtiene el número de tramas LOAD emitidas
+     */
+    unsigned long long obtenerTramasLoad() const;
+    
+    /**
+     * @brief Obtiene el número de tramas MAP emitidas
+     */
+    unsigned long long obtenerTramasMap() const;
+};
+
+#endif // CODIFICADORPRT7_H
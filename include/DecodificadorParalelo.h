@@ -0,0 +1,131 @@
+/**
+ * @file DecodificadorParalelo.h
+ * @brief Decodificación de capturas con secuencias en paralelo
+ * 
+ * Una captura contiene miles de secuencias independientes separadas por
+ * el marcador "REINICIANDO SECUENCIA", y cada una empieza con el rotor
+ * en 'A'. Se busca primero cada marcador en el texto crudo (memmem sobre
+ * el archivo mapeado) y después cada secuencia se parsea y decodifica
+ * como una tarea de un PoolDeTrabajo, con su propio rotor (o cascada
+ * de rotores) y su propia lista. Los resultados se entregan en el orden original.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef DECODIFICADORPARALELO_H
+#define DECODIFICADORPARALELO_H
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+class PoolDeTrabajo;
+class BufferDeTramas;
+
+/**
+ * @struct ResultadoSecuencia
+ * @brief Mensaje decodificado de una secuencia (lo llena un hilo del pool)
+ */
+struct ResultadoSecuencia {
+    const char* inicio;      ///< Primer byte de la secuencia en la captura
+    std::size_t longitud;    ///< Bytes de la secuencia en la captura
+    char* mensaje;           ///< Mensaje decodificado (nullptr si está vacío)
+    std::size_t longMensaje; ///< Caracteres del mensaje
+    int errores;             ///< Tramas mal formadas descartadas
+    bool listo;              ///< true cuando la tarea terminó (protegido por el mutex)
+};
+
+/**
+ * @class DecodificadorParalelo
+ * @brief Decodifica una captura completa usando todos los núcleos
+ */
+class DecodificadorParalelo {
+public:
+    /**
+     * @brief Función llamada con cada secuencia, en orden y en el hilo que llamó a decodificar()
+     * @param mensaje Mensaje decodificado (no terminado en '\\0')
+     * @param longitud Número de caracteres (las secuencias vacías no se entregan)
+     * @param contexto Puntero de usuario
+     */
+    typedef void (*AlTerminarSecuencia)(const char* mensaje, std::size_t longitud, void* contexto);
+
+private:
+    PoolDeTrabajo* pool;             ///< Hilos trabajadores
+    BufferDeTramas** buffers;        ///< Buffer de tramas reutilizable por hilo
+    int numRotores;                  ///< 1 = rotor simple, >1 = cascada por secuencia
+    
+    ResultadoSecuencia* resultados;  ///< Una entrada por secuencia
+    int numSecuencias;               ///< Secuencias de la captura actual
+    
+    std::mutex mutex;                ///< Protege ResultadoSecuencia::listo
+    std::condition_variable terminada;  ///< Avisa cada secuencia terminada
+    
+    /**
+     * @brief Divide la captura en secuencias (una por marcador de reinicio)
+     */
+    void dividir(const char* datos, std::size_t longitud);
+    
+    /**
+     * @brief Tarea del pool: parsea y decodifica una secuencia
+     */
+    static void decodificarSecuencia(int indice, int hilo, void* contexto);
+    
+    // No copiable: es dueño del pool y de los buffers
+    DecodificadorParalelo(const DecodificadorParalelo&);
+    DecodificadorParalelo& operator=(const DecodificadorParalelo&);
+
+public:
+    /**
+     * @brief Constructor
+     * @param numHilos Hilos trabajadores (0 = uno por núcleo)
+     * @param rotores Número de rotores (1 = protocolo original; se usa al menos 1)
+     */
+    explicit DecodificadorParalelo(int numHilos = 0, int rotores = 1);
+    
+    /**
+     * @brief Destructor
+     */
+    ~DecodificadorParalelo();
+    
+    /**
+     * @brief Decodifica una captura en memoria
+     * 
+     * Bloquea hasta entregar todas las secuencias. Cada una se entrega
+     * en cuanto ella y todas las anteriores terminaron.
+     * 
+     * @param datos Texto de la captura
+     * @param longitud Número de bytes
+     * @param fin Función llamada con cada secuencia no vacía, en orden
+     * @param contexto Puntero de usuario para fin
+     * @return Número de tramas mal formadas descartadas
+     */
+    int decodificar(const char* datos, std::size_t longitud,
+                    AlTerminarSecuencia fin, void* contexto);
+    
+    /**
+     * @brief Decodifica un archivo de captura (mapeado con mmap)
+     * @param ruta Ruta del archivo
+     * @param fin Función llamada con cada secuencia no vacía, en orden
+     * @param contexto Puntero de usuario para fin
+     * @return Tramas mal formadas descartadas, o -1 si no se pudo abrir
+     */
+    int decodificarArchivo(const char* ruta, AlTerminarSecuencia fin, void* contexto);
+    
+    /**
+     * @brief Obtiene el número de hilos trabajadores
+     */
+    int obtenerNumHilos() const;
+    
+    /**
+     * @brief Obtiene las secuencias de la última captura (incluye vacías)
+     */
+    int obtenerNumSecuencias() const;
+    
+    /**
+     * @brief Obtiene el número de tareas robadas entre hilos
+     */
+    unsigned long long obtenerRobos() const;
+};
+
+#endif // DECODIFICADORPARALELO_H
@@ -0,0 +1,127 @@
+/**
+ * @file DetectorDePalabras.h
+ * @brief Detección de palabras clave en línea (autómata de Aho-Corasick)
+ * 
+ * Avanza un estado por cada carácter decodificado, dentro del camino de
+ * decodificación, y avisa en cuanto termina una coincidencia, sin esperar
+ * al fin de la secuencia ni volver a recorrer el mensaje. El autómata
+ * se compila a una tabla de transiciones completa sobre el alfabeto de
+ * 27 símbolos (A-Z y espacio): cada carácter cuesta una consulta, sin
+ * importar cuántos patrones haya.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef DETECTORDEPALABRAS_H
+#define DETECTORDEPALABRAS_H
+
+#include "prt7_api.h"
+
+/**
+ * @class DetectorDePalabras
+ * @brief Autómata de Aho-Corasick sobre el alfabeto PRT-7
+ * 
+ * Uso: agregarPatron() para cada palabra, construir() una vez, y luego
+ * avanzar() con cada carácter decodificado.
+ */
+class PRT7_API DetectorDePalabras {
+public:
+    /**
+     * @brief Función llamada al completarse una coincidencia
+     * @param idPatron Identificador dado en agregarPatron()
+     * @param numSecuencia Número de secuencia (empieza en 1)
+     * @param desplazamiento Posición del primer carácter de la coincidencia en la secuencia
+     * @param contexto Puntero de usuario
+     */
+    typedef void (*AlDetectar)(int idPatron, int numSecuencia, int desplazamiento, void* contexto);
+    
+private:
+    static const int TAM_ALFABETO = 27;  ///< A-Z más espacio
+    
+    int* transiciones;   ///< Tabla [estado * 27 + símbolo] -> estado
+    int* fallo;          ///< Enlace de fallo de cada estado
+    int* patronEn;       ///< Patrón que termina en el estado (-1 si ninguno)
+    int* enlaceSalida;   ///< Siguiente estado con patrón en la cadena de fallos (-1 si ninguno)
+    int numEstados;      ///< Estados usados
+    int capEstados;      ///< Estados reservados
+    
+    int* idPatrones;     ///< Id de cada patrón
+    int* longPatrones;   ///< Longitud de cada patrón
+    int numPatrones;     ///< Patrones registrados
+    int capPatrones;     ///< Patrones reservados
+    
+    bool construido;     ///< true después de construir()
+    
+    int estado;          ///< Estado actual
+    int numSecuencia;    ///< Secuencia actual
+    int posicion;        ///< Caracteres vistos en la secuencia actual
+    
+    AlDetectar alDetectar;  ///< Función de aviso
+    void* contexto;         ///< Contexto del aviso
+    
+    /**
+     * @brief Convierte un carácter al índice de símbolo (-1 si está fuera del alfabeto)
+     */
+    static int simbolo(char c);
+    
+    int nuevoEstado();
+    
+    // No copiable
+    DetectorDePalabras(const DetectorDePalabras&);
+    DetectorDePalabras& operator=(const DetectorDePalabras&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param aviso Función llamada en cada coincidencia
+     * @param ctx Puntero de usuario para aviso
+     */
+    DetectorDePalabras(AlDetectar aviso, void* ctx);
+    
+    /**
+     * @brief Destructor
+     */
+    ~DetectorDePalabras();
+    
+    /**
+     * @brief Agrega una palabra a detectar (antes de construir())
+     * 
+     * Las minúsculas se tratan como mayúsculas.
+     * 
+     * @param palabra Palabra (solo A-Z y espacio)
+     * @param id Identificador que se entrega en el aviso
+     * @return true si se agregó, false si está vacía, tiene símbolos
+     *         fuera del alfabeto o el autómata ya se construyó
+     */
+    bool agregarPatron(const char* palabra, int id);
+    
+    /**
+     * @brief Calcula los enlaces de fallo y completa la tabla de transiciones
+     */
+    void construir();
+    
+    /**
+     * @brief Avanza el autómata con un carácter decodificado
+     * 
+     * Un carácter fuera del alfabeto regresa al estado inicial.
+     * 
+     * @param c Carácter decodificado
+     */
+    void avanzar(char c);
+    
+    /**
+     * @brief Comienza una nueva secuencia
+     * 
+     * Regresa al estado inicial y reinicia la posición. El número de
+     * secuencia solo aumenta si la secuencia actual tuvo caracteres.
+     */
+    void reiniciarSecuencia();
+    
+    /**
+     * @brief Obtiene el número de patrones registrados
+     */
+    int obtenerNumPatrones() const;
+};
+
+#endif // DETECTORDEPALABRAS_H
@@ -0,0 +1,246 @@
+/**
+ * @file EscritorAsincrono.h
+ * @brief Escritor de salida asíncrono hacia varios destinos
+ * 
+ * Un hilo dedicado toma las líneas y mensajes decodificados de una cola
+ * y los escribe en varios destinos (consola, archivo de log, socket UNIX)
+ * agrupándolos en llamadas writev. Cada destino tiene su propia cola,
+ * límite de bytes pendientes y política (descartar o bloquear), de modo
+ * que un consumidor lento no detiene la decodificación.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef ESCRITORASINCRONO_H
+#define ESCRITORASINCRONO_H
+
+#include <cstddef>
+#include <streambuf>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @struct MensajeSalida
+ * @brief Bloque de texto compartido por las colas de todos los destinos
+ * 
+ * Se libera cuando el último destino termina de escribirlo
+ * (referencias protegidas por el mutex del escritor).
+ */
+struct MensajeSalida {
+    char* datos;                   ///< Copia del texto
+    std::size_t longitud;          ///< Número de bytes
+    int referencias;               ///< Destinos que aún no lo escriben
+    unsigned long long encoladoNs; ///< Momento en que se encoló (reloj monotónico)
+};
+
+/**
+ * @struct NodoSalida
+ * @brief Nodo de la cola (lista simple) de un destino
+ */
+struct NodoSalida {
+    MensajeSalida* mensaje;  ///< Mensaje a escribir
+    NodoSalida* siguiente;   ///< Siguiente nodo de la cola
+    
+    /**
+     * @brief Constructor del nodo
+     * @param m Mensaje a encolar
+     */
+    NodoSalida(MensajeSalida* m) : mensaje(m), siguiente(nullptr) {}
+};
+
+/**
+ * @struct EstadisticasDestino
+ * @brief Contadores de un destino de salida
+ */
+struct EstadisticasDestino {
+    unsigned long long bytesEscritos;       ///< Bytes escritos con éxito
+    unsigned long long mensajesEscritos;    ///< Mensajes escritos completos
+    unsigned long long mensajesDescartados; ///< Mensajes descartados por límite
+    unsigned long long bytesDescartados;    ///< Bytes descartados por límite
+    unsigned long long llamadasWritev;      ///< Llamadas a writev realizadas
+    unsigned long long latenciaTotalNs;     ///< Suma de latencias (encolado -> escrito)
+    unsigned long long latenciaMaxNs;       ///< Latencia máxima observada
+    bool error;                             ///< true si el destino falló y se desactivó
+};
+
+/**
+ * @class EscritorAsincrono
+ * @brief Hilo de salida con colas por destino y escritura por lotes (writev)
+ */
+class EscritorAsincrono {
+public:
+    /**
+     * @brief Qué hacer cuando un destino supera su límite de bytes pendientes
+     */
+    enum Politica {
+        DESCARTAR,  ///< Descartar el mensaje para ese destino (nunca detiene al productor)
+        BLOQUEAR    ///< Esperar a que el destino libere espacio
+    };
+    
+    static const int MAX_DESTINOS = 8;  ///< Número máximo de destinos
+    
+private:
+    /**
+     * @struct Destino
+     * @brief Estado interno de un destino
+     */
+    struct Destino {
+        int fd;                     ///< Descriptor de escritura
+        bool propio;                ///< true si el escritor debe cerrarlo
+        Politica politica;          ///< Política al superar el límite
+        std::size_t limiteBytes;    ///< Límite de bytes pendientes
+        std::size_t bytesPendientes;///< Bytes en cola aún no escritos
+        std::size_t desplazamiento; ///< Bytes ya escritos del primer mensaje
+        NodoSalida* cabeza;         ///< Primer mensaje pendiente
+        NodoSalida* cola;           ///< Último mensaje pendiente
+        EstadisticasDestino estadisticas; ///< Contadores
+    };
+    
+    Destino destinos[MAX_DESTINOS];  ///< Destinos registrados
+    int numDestinos;                 ///< Número de destinos registrados
+    
+    std::mutex mutex;                      ///< Protege colas y contadores
+    std::condition_variable espacioLibre;  ///< Avisa a productores bloqueados
+    std::thread hilo;                      ///< Hilo escritor
+    bool enMarcha;                         ///< true entre iniciar() y detener()
+    bool deteniendo;                       ///< Solicitud de detener el hilo
+    bool abortando;                        ///< Venció el plazo: salir sin vaciar colas
+    int tuberiaDespertar[2];               ///< Self-pipe para despertar a poll()
+    
+    void bucleEscritor();
+    void escribirLote(int indice);
+    void liberarNodo(Destino& d, NodoSalida* nodo, bool escrito);
+    void vaciarDestino(Destino& d);
+    bool colasVacias() const;
+    void despertar();
+    
+    // No copiable
+    EscritorAsincrono(const EscritorAsincrono&);
+    EscritorAsincrono& operator=(const EscritorAsincrono&);
+    
+public:
+    /**
+     * @brief Constructor
+     * 
+     * Crea un escritor sin destinos; el hilo arranca con iniciar().
+     */
+    EscritorAsincrono();
+    
+    /**
+     * @brief Destructor
+     * 
+     * Detiene el hilo (escribiendo lo pendiente) y cierra los destinos propios.
+     */
+    ~EscritorAsincrono();
+    
+    /**
+     * @brief Registra un descriptor ya abierto como destino
+     * 
+     * Un descriptor propio se pone en modo no bloqueante. Uno ajeno no se
+     * toca, porque O_NONBLOCK afectaría a todos los que comparten su
+     * descripción (stdin y stderr en una terminal): si es terminal o
+     * tubería se reabre por /proc/self/fd y el escritor usa la copia;
+     * si no, el hilo escribe en él bloqueando.
+     * 
+     * @param fd Descriptor de escritura
+     * @param politica Política al superar el límite
+     * @param limiteBytes Límite de bytes pendientes en la cola del destino
+     * @param propio true para que el escritor lo cierre al destruirse
+     * @return Índice del destino, -1 si no hay espacio o ya está en marcha
+     */
+    int agregarDescriptor(int fd, Politica politica, std::size_t limiteBytes, bool propio = false);
+    
+    /**
+     * @brief Abre (o crea) un archivo en modo append como destino
+     * @return Índice del destino, -1 si falla
+     */
+    int agregarArchivo(const char* ruta, Politica politica, std::size_t limiteBytes);
+    
+    /**
+     * @brief Conecta a un socket UNIX (SOCK_STREAM) como destino
+     * 
+     * Ignora SIGPIPE para que un consumidor desconectado solo desactive
+     * su destino.
+     * 
+     * @return Índice del destino, -1 si falla
+     */
+    int agregarSocketUnix(const char* ruta, Politica politica, std::size_t limiteBytes);
+    
+    /**
+     * @brief Arranca el hilo escritor
+     * @return true si arrancó
+     */
+    bool iniciar();
+    
+    /**
+     * @brief Escribe lo pendiente y detiene el hilo
+     * 
+     * Espera como máximo esperaMaxMs a los destinos lentos; lo que quede
+     * después se descarta.
+     * 
+     * @param esperaMaxMs Tiempo máximo de espera en milisegundos
+     */
+    void detener(int esperaMaxMs = 2000);
+    
+    /**
+     * @brief Encola un bloque de texto para todos los destinos
+     * 
+     * Copia los datos; nunca llama a write desde el hilo del productor.
+     * 
+     * @param datos Texto a escribir
+     * @param longitud Número de bytes
+     */
+    void escribir(const char* datos, std::size_t longitud);
+    
+    /**
+     * @brief Obtiene una copia de los contadores de un destino
+     * @param indice Índice del destino
+     * @return Contadores (todos en cero si el índice no es válido)
+     */
+    EstadisticasDestino obtenerEstadisticas(int indice);
+    
+    /**
+     * @brief Obtiene el número de destinos registrados
+     */
+    int obtenerNumDestinos() const;
+};
+
+/**
+ * @class FlujoAsincrono
+ * @brief Adaptador std::streambuf que envía la salida a un EscritorAsincrono
+ * 
+ * Permite redirigir std::cout (std::cout.rdbuf(&flujo)) sin tocar el
+ * código que imprime. Cada flush (std::endl) o buffer lleno se encola
+ * como un mensaje.
+ */
+class FlujoAsincrono : public std::streambuf {
+private:
+    static const int TAM_BUFFER = 4096;  ///< Tamaño del buffer de líneas
+    
+    EscritorAsincrono* escritor;  ///< Escritor destino
+    char buffer[TAM_BUFFER];      ///< Área de escritura
+    
+    void enviar();
+    
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+    
+public:
+    /**
+     * @brief Constructor
+     * @param e Escritor al que se envía la salida
+     */
+    explicit FlujoAsincrono(EscritorAsincrono* e);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Envía lo que quede en el buffer.
+     */
+    ~FlujoAsincrono();
+};
+
+#endif // ESCRITORASINCRONO_H
@@ -12,6 +12,14 @@
 #ifndef LISTADECARGA_H
 #define LISTADECARGA_H
 
+#include <cstddef>
+#include <iterator>
+#include "prt7_api.h"
+
+class DetectorDePalabras;
+class VentanaDeCarga;
+class MensajeEmpaquetado;
+
 /**
  * @struct NodoCarga
  * @brief Nodo de la lista doblemente enlazada
@@ -39,14 +47,117 @@ struct NodoCarga {
  * 
  * Almacena los caracteres en el orden en que son decodificados,
  * manteniendo la estructura del mensaje final.
+ * 
+ * En modo ventana (setVentana) no se crean nodos: los caracteres
+ * decodificados van a una VentanaDeCarga de memoria fija. En ese modo
+ * copiarA exporta solo el campo decodificado: lo derramado al segmento
+ * y lo que sigue en memoria. Lo que se perdió al derramar (sin segmento
+ * o tras un error de escritura) cuenta en obtenerTamanio() pero no se
+ * puede copiar; obtenerCopiables() dice cuánto se exporta.
+ * 
+ * En modo empaquetado (setEmpaquetado) tampoco hay nodos: ambos campos
+ * van a un MensajeEmpaquetado de 5 bits por símbolo (unas 20 veces menos
+ * memoria que un NodoCarga). copiarA e imprimir funcionan igual.
+ * 
+ * Los iteradores recorren lo mismo que exporta copiarA en los tres
+ * modos: en ventana y empaquetado leen por posición.
  */
-class ListaDeCarga {
+class PRT7_API ListaDeCarga {
 private:
     NodoCarga* cabeza;  ///< Puntero al primer nodo
     NodoCarga* cola;    ///< Puntero al último nodo
     int tamanio;        ///< Número de elementos en la lista
+    DetectorDePalabras* detector;  ///< Detector de palabras (opcional, no es dueña)
+    VentanaDeCarga* ventana;       ///< Ventana de memoria fija (opcional, no es dueña)
+    MensajeEmpaquetado* empaquetado;  ///< Almacenamiento de 5 bits (opcional, no es dueña)
+    
+    /**
+     * @brief Libera todos los nodos
+     */
+    void liberarNodos();
     
 public:
+    /**
+     * @brief Campo del nodo que expone un iterador o una exportación
+     */
+    enum Campo {
+        CODIFICADO,   ///< Carácter tal como llegó en la trama LOAD
+        DECODIFICADO  ///< Carácter después del mapeo del rotor
+    };
+    
+    /**
+     * @class Iterador
+     * @brief Iterador bidireccional de solo lectura sobre el mensaje
+     * 
+     * Compatible con los algoritmos estándar (std::bidirectional_iterator_tag).
+     * Recorre el carácter codificado o el decodificado según el campo con
+     * el que fue creado. Con nodos sigue los enlaces; en modo ventana o
+     * empaquetado lee por posición (VentanaDeCarga::leer,
+     * MensajeEmpaquetado::leer) lo mismo que exporta copiarA. Devuelve
+     * el carácter por valor: en esos modos no hay un char en memoria al
+     * que apuntar. Dos iteradores se comparan por su posición, así que
+     * solo deben compararse iteradores de la misma lista. El iterador
+     * final puede decrementarse para llegar al último carácter.
+     */
+    class Iterador {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef char value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const char* pointer;
+        typedef char reference;
+        
+        Iterador() : nodo(nullptr), lista(nullptr), campo(DECODIFICADO), posicion(0) {}
+        
+        /**
+         * @brief Constructor
+         * @param n Nodo actual (nullptr sin nodos o en el final)
+         * @param l Lista recorrida
+         * @param c Campo a exponer
+         * @param p Posición desde el inicio del mensaje
+         */
+        Iterador(const NodoCarga* n, const ListaDeCarga* l, Campo c, std::size_t p)
+            : nodo(n), lista(l), campo(c), posicion(p) {}
+        
+        reference operator*() const {
+            if (nodo == nullptr) return lista->leerCaracter(posicion, campo);
+            return campo == CODIFICADO ? nodo->datoCodificado : nodo->datoDecodificado;
+        }
+        
+        Iterador& operator++() {
+            if (nodo != nullptr) nodo = nodo->siguiente;
+            posicion++;
+            return *this;
+        }
+        
+        Iterador operator++(int) {
+            Iterador copia = *this;
+            ++(*this);
+            return copia;
+        }
+        
+        Iterador& operator--() {
+            if (lista->tieneNodos()) nodo = (nodo == nullptr) ? lista->cola : nodo->previo;
+            posicion--;
+            return *this;
+        }
+        
+        Iterador operator--(int) {
+            Iterador copia = *this;
+            --(*this);
+            return copia;
+        }
+        
+        bool operator==(const Iterador& otro) const { return posicion == otro.posicion; }
+        bool operator!=(const Iterador& otro) const { return posicion != otro.posicion; }
+        
+    private:
+        const NodoCarga* nodo;      ///< Nodo actual (nullptr = sin nodos o final)
+        const ListaDeCarga* lista;  ///< Lista recorrida
+        Campo campo;                ///< Campo expuesto por el iterador
+        std::size_t posicion;       ///< Posición en lo que exporta copiarA
+    };
+    
     /**
      * @brief Constructor
      * 
@@ -93,6 +204,102 @@ public:
      * @return true si está vacía, false en caso contrario
      */
     bool estaVacia() const;
+    
+    /**
+     * @brief Elimina todos los nodos de la lista
+     * 
+     * La lista queda vacía y lista para reutilizarse. Si hay un detector
+     * asociado, comienza una nueva secuencia.
+     */
+    void vaciar();
+    
+    /**
+     * @brief Asocia un detector de palabras a la lista
+     * 
+     * Cada carácter decodificado que se inserta avanza el detector.
+     * 
+     * @param d Detector (nullptr para quitarlo); la lista no lo libera
+     */
+    void setDetector(DetectorDePalabras* d);
+    
+    /**
+     * @brief Activa el modo ventana (memoria acotada)
+     * 
+     * Debe llamarse con la lista vacía. vaciar() también vacía la ventana.
+     * 
+     * @param v Ventana (nullptr para volver a la lista); la lista no la libera
+     */
+    void setVentana(VentanaDeCarga* v);
+    
+    /**
+     * @brief Activa el modo empaquetado (5 bits por símbolo)
+     * 
+     * Debe llamarse con la lista vacía. vaciar() también vacía el
+     * mensaje empaquetado. Si hay ventana, la ventana tiene prioridad.
+     * 
+     * @param m Mensaje empaquetado (nullptr para volver a la lista); la lista no lo libera
+     */
+    void setEmpaquetado(MensajeEmpaquetado* m);
+    
+    /**
+     * @brief Iterador al primer carácter decodificado
+     * @return Iterador al inicio (permite usar for por rango)
+     */
+    Iterador begin() const { return Iterador(cabeza, this, DECODIFICADO, 0); }
+    
+    /**
+     * @brief Iterador después del último carácter decodificado
+     */
+    Iterador end() const { return Iterador(nullptr, this, DECODIFICADO, obtenerCopiables(DECODIFICADO)); }
+    
+    /**
+     * @brief Iterador al primer carácter codificado
+     */
+    Iterador beginCodificado() const { return Iterador(cabeza, this, CODIFICADO, 0); }
+    
+    /**
+     * @brief Iterador después del último carácter codificado
+     * 
+     * En modo ventana es igual a beginCodificado(): la ventana no guarda ese campo.
+     */
+    Iterador endCodificado() const { return Iterador(nullptr, this, CODIFICADO, obtenerCopiables(CODIFICADO)); }
+    
+    /**
+     * @brief Copia el mensaje a un buffer de caracteres
+     * 
+     * Escribe como máximo capacidad - 1 caracteres y siempre termina
+     * el buffer con '\0' (si capacidad > 0).
+     * 
+     * @param buffer Buffer de destino
+     * @param capacidad Tamaño del buffer en bytes
+     * @param campo Campo a copiar (decodificado por defecto)
+     * @return Número de caracteres copiados (sin contar el '\0')
+     */
+    std::size_t copiarA(char* buffer, std::size_t capacidad, Campo campo = DECODIFICADO) const;
+    
+    /**
+     * @brief Obtiene cuántos caracteres exporta copiarA con un buffer suficiente
+     * 
+     * Igual a obtenerTamanio() salvo en modo ventana: 0 para el campo
+     * codificado (no se guarda) y, para el decodificado, sin el tramo que
+     * se perdió al derramar.
+     * 
+     * @param campo Campo a copiar
+     * @return Número de caracteres
+     */
+    std::size_t obtenerCopiables(Campo campo = DECODIFICADO) const;
+    
+    /**
+     * @brief Verifica si el mensaje está en nodos
+     * @return false en modo ventana o empaquetado (los iteradores leen por posición)
+     */
+    bool tieneNodos() const;
+    
+private:
+    /**
+     * @brief Carácter en una posición de lo que exporta copiarA (modos ventana y empaquetado)
+     */
+    char leerCaracter(std::size_t posicion, Campo campo) const;
 };
 
 #endif // LISTADECARGA_H
@@ -0,0 +1,180 @@
+/**
+ * @file MensajeEmpaquetado.h
+ * @brief Almacenamiento compacto de 5 bits por símbolo para mensajes archivados
+ * 
+ * El alfabeto PRT-7 tiene 27 símbolos (A-Z y espacio), así que cada
+ * carácter cabe en 5 bits. Un mensaje empaquetado guarda el texto
+ * codificado y el decodificado en palabras de 64 bits (12 símbolos por
+ * palabra), en lugar de un NodoCarga con dos char y dos punteros por
+ * carácter. En el campo decodificado las minúsculas se guardan como
+ * mayúsculas (el rotor no distingue "L,h" de "L,H"); el codificado
+ * devuelve lo recibido tal cual. Los caracteres fuera del alfabeto de
+ * cada campo se marcan con un símbolo de escape y se guardan sin
+ * comprimir en una lista aparte.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef MENSAJEEMPAQUETADO_H
+#define MENSAJEEMPAQUETADO_H
+
+#include <cstddef>
+#include "prt7_api.h"
+#include "ListaDeCarga.h"
+
+/**
+ * @struct FlujoEmpaquetado
+ * @brief Símbolos de un campo (codificado o decodificado) en palabras de 64 bits
+ */
+struct FlujoEmpaquetado {
+    unsigned long long* palabras;  ///< 12 símbolos de 5 bits por palabra
+    std::size_t capPalabras;       ///< Palabras reservadas
+    std::size_t* posExcepciones;   ///< Posición de cada carácter fuera del alfabeto (ascendente)
+    char* valExcepciones;          ///< Carácter original de cada excepción
+    std::size_t numExcepciones;    ///< Excepciones usadas
+    std::size_t capExcepciones;    ///< Excepciones reservadas
+};
+
+/**
+ * @class MensajeEmpaquetado
+ * @brief Mensaje (codificado + decodificado) empaquetado a 5 bits por símbolo
+ */
+class PRT7_API MensajeEmpaquetado {
+public:
+    static const int SIMBOLOS_POR_PALABRA = 12;  ///< 12 x 5 = 60 bits por palabra
+    static const unsigned char ESCAPE = 31;      ///< Símbolo para caracteres fuera del alfabeto
+    
+private:
+    FlujoEmpaquetado flujos[2];  ///< Índice ListaDeCarga::Campo
+    std::size_t tamanio;         ///< Número de caracteres
+    
+    void reservarPalabras(FlujoEmpaquetado& f, std::size_t palabras);
+    void agregarExcepcion(FlujoEmpaquetado& f, std::size_t posicion, char valor);
+    void agregarCampo(ListaDeCarga::Campo campo, const char* texto, std::size_t n);
+    void imprimirDecodificado(bool corchetes) const;
+    
+    // No copiable
+    MensajeEmpaquetado(const MensajeEmpaquetado&);
+    MensajeEmpaquetado& operator=(const MensajeEmpaquetado&);
+    
+public:
+    /**
+     * @brief Constructor
+     * 
+     * Crea un mensaje vacío.
+     */
+    MensajeEmpaquetado();
+    
+    /**
+     * @brief Destructor
+     */
+    ~MensajeEmpaquetado();
+    
+    /**
+     * @brief Agrega un carácter (codificado y decodificado) al final
+     */
+    void agregar(char codificado, char decodificado);
+    
+    /**
+     * @brief Agrega n caracteres de una vez con el núcleo de empaquetado por bloques
+     * @param codificados Caracteres codificados
+     * @param decodificados Caracteres decodificados
+     * @param n Número de caracteres
+     */
+    void agregarBloque(const char* codificados, const char* decodificados, std::size_t n);
+    
+    /**
+     * @brief Empaqueta (al final) todo el contenido de una lista de carga
+     * 
+     * Una lista en modo ventana no guarda el campo codificado y no agrega nada.
+     * 
+     * @param lista Lista a archivar
+     */
+    void agregarLista(const ListaDeCarga& lista);
+    
+    /**
+     * @brief Desempaqueta el mensaje a un buffer de caracteres
+     * 
+     * Mismo contrato que ListaDeCarga::copiarA: como máximo capacidad - 1
+     * caracteres y el buffer siempre termina en '\\0'.
+     * 
+     * @return Número de caracteres copiados
+     */
+    std::size_t copiarA(char* buffer, std::size_t capacidad,
+                        ListaDeCarga::Campo campo = ListaDeCarga::DECODIFICADO) const;
+    
+    /**
+     * @brief Lee un carácter por posición sin desempaquetar el mensaje
+     * 
+     * Desempaqueta solo la palabra que lo contiene; las excepciones se
+     * buscan por bisección. Es lo que usan los iteradores de ListaDeCarga.
+     * 
+     * @param posicion Posición desde el inicio del mensaje
+     * @param campo Campo a leer
+     * @return Carácter, o '\\0' si la posición está fuera del mensaje
+     */
+    char leer(std::size_t posicion, ListaDeCarga::Campo campo = ListaDeCarga::DECODIFICADO) const;
+    
+    /**
+     * @brief Imprime el mensaje decodificado completo en consola
+     */
+    void imprimirMensaje() const;
+    
+    /**
+     * @brief Imprime el mensaje decodificado en formato [X][Y][Z]
+     * 
+     * Desempaqueta de a una palabra (12 símbolos) en un buffer local:
+     * no reserva memoria aunque se llame con cada trama LOAD.
+     */
+    void imprimirMensajeParcial() const;
+    
+    /**
+     * @brief Elimina el contenido (conserva la memoria reservada)
+     */
+    void vaciar();
+    
+    /**
+     * @brief Libera la memoria reservada de más (para mensajes ya archivados)
+     */
+    void ajustarMemoria();
+    
+    /**
+     * @brief Obtiene el número de caracteres
+     */
+    std::size_t obtenerTamanio() const;
+    
+    /**
+     * @brief Bytes de memoria dinámica usados por el mensaje
+     */
+    std::size_t bytesUsados() const;
+    
+    /**
+     * @brief Núcleo de empaquetado: convierte n caracteres a palabras de 5 bits
+     * 
+     * Escribe ceil(n / 12) palabras. Los caracteres fuera del alfabeto
+     * quedan como ESCAPE.
+     * 
+     * @param texto Caracteres de entrada
+     * @param n Número de caracteres
+     * @param palabras Destino
+     * @param plegarMinusculas Empaquetar las minúsculas como mayúsculas (si
+     *        es falso son ESCAPE y el llamador las guarda como excepciones)
+     * @return Número de caracteres fuera del alfabeto
+     */
+    static std::size_t empaquetar(const char* texto, std::size_t n, unsigned long long* palabras,
+                                  bool plegarMinusculas = true);
+    
+    /**
+     * @brief Núcleo de desempaquetado: convierte palabras de 5 bits a caracteres
+     * 
+     * Los símbolos ESCAPE se escriben como '?' (el llamador los corrige).
+     * 
+     * @param palabras Palabras de entrada
+     * @param n Número de caracteres a escribir
+     * @param texto Destino (n caracteres, sin '\\0')
+     */
+    static void desempaquetar(const unsigned long long* palabras, std::size_t n, char* texto);
+};
+
+#endif // MENSAJEEMPAQUETADO_H
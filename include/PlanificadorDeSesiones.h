@@ -0,0 +1,146 @@
+/**
+ * @file PlanificadorDeSesiones.h
+ * @brief Un solo hilo que atiende miles de sesiones PRT-7 con epoll
+ * 
+ * Un hilo por dispositivo (real o simulado) no escala a decenas de miles
+ * de fuentes. Aquí cada fuente es un descriptor (pipe, pty, puerto
+ * serial, socket) con su SesionPRT7, y un solo ciclo epoll las reanuda
+ * cuando hay bytes listos. La sesión guarda entre lecturas todo su
+ * estado (línea pendiente, rotor, mensaje), así que suspenderla no
+ * necesita pila propia: cuesta lo que ocupa la sesión.
+ * 
+ * La biblioteca es C++11, sin corrutinas: cada SesionPRT7 es una
+ * máquina de estados reanudable y alimentar() es el punto de
+ * reanudación. Una corrutina por dispositivo guardaría lo mismo en su
+ * marco; aquí el estado ya vive en la sesión y no hace falta asignarlo.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef PLANIFICADORDESESIONES_H
+#define PLANIFICADORDESESIONES_H
+
+#include <cstddef>
+#include "prt7_api.h"
+
+class SesionPRT7;
+
+/**
+ * @class PlanificadorDeSesiones
+ * @brief Ciclo de eventos cooperativo para sesiones alimentadas por descriptores
+ * 
+ * En cada turno una sesión lista hace a lo más una lectura de
+ * TAM_QUANTUM bytes y vuelve al ciclo; epoll (por nivel) la vuelve a
+ * reportar si le quedan datos. Así un flujo muy rápido no deja sin
+ * turno a los demás. Todo ocurre en el hilo que llama a
+ * atenderEventos(): las sesiones y sus eventos no necesitan candados.
+ */
+class PRT7_API PlanificadorDeSesiones {
+public:
+    /**
+     * @brief Función llamada cuando una fuente termina (fin de datos o error)
+     * 
+     * La sesión ya procesó su última línea; después de la llamada se
+     * cierra el descriptor y se libera la sesión.
+     * 
+     * @param fd Descriptor de la fuente
+     * @param sesion Sesión de la fuente
+     * @param contexto Puntero de usuario
+     */
+    typedef void (*AlCerrar)(int fd, SesionPRT7* sesion, void* contexto);
+    
+    static const std::size_t TAM_QUANTUM = 4096;  ///< Bytes por lectura y por turno
+
+private:
+    int epollFd;                ///< Descriptor de epoll
+    SesionPRT7** sesiones;      ///< Tabla de sesiones indexada por fd
+    int capSesiones;            ///< Tamaño de la tabla
+    int sesionesActivas;        ///< Fuentes registradas
+    char* bloque;               ///< Buffer de lectura compartido por todas las sesiones
+    
+    AlCerrar alCerrar;          ///< Aviso de fuente terminada (puede ser nullptr)
+    void* contexto;             ///< Contexto de usuario
+    bool detenido;              ///< detener() pidió salir de ejecutar()
+    
+    unsigned long long bytesLeidos;  ///< Bytes entregados a las sesiones
+    unsigned long long lecturas;     ///< Turnos con datos
+    
+    /**
+     * @brief Da un turno a la sesión de fd (una lectura)
+     */
+    void atender(int fd);
+    
+    /**
+     * @brief Avisa, cierra el descriptor y libera la sesión
+     */
+    void cerrar(int fd);
+    
+    // No copiable: es dueño de los descriptores y de las sesiones
+    PlanificadorDeSesiones(const PlanificadorDeSesiones&);
+    PlanificadorDeSesiones& operator=(const PlanificadorDeSesiones&);
+
+public:
+    /**
+     * @brief Constructor
+     * @param f Aviso de fuente terminada (nullptr = sin aviso)
+     * @param ctx Contexto de usuario para f
+     */
+    explicit PlanificadorDeSesiones(AlCerrar f = nullptr, void* ctx = nullptr);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Cierra los descriptores y libera las sesiones que sigan registradas.
+     */
+    ~PlanificadorDeSesiones();
+    
+    /**
+     * @brief Registra una fuente
+     * 
+     * El descriptor pasa a modo no bloqueante. Si tiene éxito el
+     * planificador queda como dueño del descriptor y de la sesión; si
+     * falla, el descriptor conserva sus banderas originales.
+     * Los eventos de la sesión no deben llamar a SesionPRT7::detener():
+     * los bytes no consumidos de la lectura se perderían.
+     * 
+     * @param fd Descriptor de lectura
+     * @param sesion Sesión creada con new
+     * @return false si no se pudo registrar (el llamador conserva ambos)
+     */
+    bool agregar(int fd, SesionPRT7* sesion);
+    
+    /**
+     * @brief Atiende una ronda de eventos
+     * @param esperaMs Tiempo máximo de espera (-1 = indefinido, 0 = no esperar)
+     * @return Número de fuentes atendidas, -1 si hubo error
+     */
+    int atenderEventos(int esperaMs);
+    
+    /**
+     * @brief Atiende eventos hasta que no queden fuentes o se llame a detener()
+     */
+    void ejecutar();
+    
+    /**
+     * @brief Pide a ejecutar() que termine (desde un evento o un AlCerrar)
+     */
+    void detener();
+    
+    /**
+     * @brief Obtiene el número de fuentes registradas
+     */
+    int obtenerSesionesActivas() const;
+    
+    /**
+     * @brief Obtiene los bytes entregados a las sesiones
+     */
+    unsigned long long obtenerBytesLeidos() const;
+    
+    /**
+     * @brief Obtiene el número de turnos con datos
+     */
+    unsigned long long obtenerLecturas() const;
+};
+
+#endif // PLANIFICADORDESESIONES_H
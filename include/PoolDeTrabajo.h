@@ -0,0 +1,142 @@
+/**
+ * @file PoolDeTrabajo.h
+ * @brief Grupo de hilos con robo de trabajo (work stealing)
+ * 
+ * Cada hilo tiene su propia cola de tareas. El dueño toma tareas del
+ * frente de su cola; cuando se queda sin trabajo roba del final de la
+ * cola de otro hilo. Así se reparte la carga aunque las tareas tengan
+ * duraciones muy distintas (secuencias de longitudes muy variables).
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef POOLDETRABAJO_H
+#define POOLDETRABAJO_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/**
+ * @struct ColaDeTrabajo
+ * @brief Tareas pendientes de un hilo: el tramo de índices [inicio, fin)
+ * 
+ * El reparto inicial es contiguo y solo se consume por los extremos
+ * (el dueño desde inicio, los ladrones desde fin), así que la cola es
+ * un rango. Las tareas son gruesas (una secuencia completa): un mutex
+ * por cola basta. La función y el contexto del lote viven en la cola
+ * para que un índice siempre se tome junto con la función de su lote.
+ */
+struct ColaDeTrabajo {
+    std::mutex mutex;   ///< Protege todos los campos
+    int inicio;         ///< Siguiente tarea del dueño
+    int fin;            ///< Una después de la última tarea
+    void (*tarea)(int indice, int hilo, void* contexto);  ///< Función del lote del tramo
+    void* contexto;     ///< Contexto del lote del tramo
+    
+    ColaDeTrabajo() : inicio(0), fin(0), tarea(nullptr), contexto(nullptr) {}
+};
+
+/**
+ * @class PoolDeTrabajo
+ * @brief Ejecuta lotes de tareas indexadas en varios hilos
+ * 
+ * Los hilos se crean una vez y duermen entre lotes. Una tarea es una
+ * función con el índice de tarea, el número del hilo que la ejecuta
+ * (para usar memoria de trabajo por hilo) y un contexto de usuario.
+ */
+class PoolDeTrabajo {
+public:
+    /**
+     * @brief Función de tarea
+     * @param indice Índice de la tarea dentro del lote
+     * @param hilo Número del hilo que la ejecuta (0 .. numHilos-1)
+     * @param contexto Puntero de usuario pasado a lanzar()
+     */
+    typedef void (*Tarea)(int indice, int hilo, void* contexto);
+
+private:
+    int numHilos;                ///< Hilos del grupo
+    std::thread* hilos;          ///< Hilos trabajadores
+    ColaDeTrabajo* colas;        ///< Una cola por hilo
+    
+    std::mutex mutex;            ///< Protege lote, activos y terminar
+    std::condition_variable hayTrabajo;   ///< Despierta a los hilos con un lote nuevo
+    std::condition_variable loteTerminado;  ///< Avisa a esperar()
+    
+    unsigned long lote;          ///< Número de lote (para despertar una sola vez)
+    std::atomic<int> pendientes; ///< Tareas del lote sin terminar
+    int activos;                 ///< Hilos que aún recorren las colas del lote
+    bool terminar;               ///< Pide a los hilos que salgan
+    
+    std::atomic<unsigned long long> robos;  ///< Tareas tomadas de otra cola
+    
+    /**
+     * @brief Ciclo de cada hilo trabajador
+     */
+    void trabajar(int hilo);
+    
+    /**
+     * @brief Toma la siguiente tarea (propia o robada)
+     * 
+     * La función y el contexto se leen con el mismo candado que el
+     * índice: un hilo que despertó tarde nunca combina un índice de un
+     * lote con la función del anterior.
+     * 
+     * @param f Salida: función del lote de la tarea
+     * @param ctx Salida: contexto del lote de la tarea
+     * @return Índice de tarea o -1 si no queda ninguna
+     */
+    int tomarTarea(int hilo, Tarea* f, void** ctx);
+    
+    // No copiable: es dueño de los hilos
+    PoolDeTrabajo(const PoolDeTrabajo&);
+    PoolDeTrabajo& operator=(const PoolDeTrabajo&);
+
+public:
+    /**
+     * @brief Constructor: crea los hilos
+     * @param hilosPedidos Número de hilos (0 = uno por núcleo)
+     */
+    explicit PoolDeTrabajo(int hilosPedidos = 0);
+    
+    /**
+     * @brief Destructor: espera el lote actual y une los hilos
+     */
+    ~PoolDeTrabajo();
+    
+    /**
+     * @brief Reparte un lote de tareas y despierta a los hilos (no bloquea)
+     * 
+     * Las tareas se reparten en tramos contiguos, uno por hilo. Solo
+     * puede haber un lote a la vez: llamar a esperar() antes del siguiente.
+     * 
+     * @param numTareas Número de tareas (índices 0 .. numTareas-1)
+     * @param f Función de tarea
+     * @param ctx Contexto de usuario
+     */
+    void lanzar(int numTareas, Tarea f, void* ctx);
+    
+    /**
+     * @brief Bloquea hasta que terminen todas las tareas del lote
+     * 
+     * También espera a que todos los hilos dejen de buscar tareas. Un
+     * hilo que despierte después toma la función junto con cada índice,
+     * así que el contexto del lote se puede liberar al volver.
+     */
+    void esperar();
+    
+    /**
+     * @brief Obtiene el número de hilos
+     */
+    int obtenerNumHilos() const;
+    
+    /**
+     * @brief Obtiene el número de tareas robadas desde la creación
+     */
+    unsigned long long obtenerRobos() const;
+};
+
+#endif // POOLDETRABAJO_H
@@ -0,0 +1,65 @@
+/**
+ * @file PuertoSerial.h
+ * @brief Configuración del puerto serial (termios) y perfiles de lectura
+ * 
+ * Abre y configura el puerto serial del receptor: velocidad, 8N1 en
+ * modo no canónico y VMIN/VTIME según el perfil de lectura. La usan el
+ * modo interactivo y la medición de perfiles sobre una pty.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef PUERTOSERIAL_H
+#define PUERTOSERIAL_H
+
+#include <termios.h>
+
+/**
+ * @brief Perfil de lectura del puerto serial (VMIN/VTIME y latencia del driver)
+ */
+enum PerfilSerial {
+    PERFIL_CLASICO,        ///< VMIN=0, VTIME=10: el read() vuelve con lo disponible o tras 1 s sin datos
+    PERFIL_BAJA_LATENCIA,  ///< VMIN=1, VTIME=0 y ASYNC_LOW_LATENCY: despierta con el primer byte
+    PERFIL_VOLUMEN         ///< VMIN=1, VTIME=0 y read() de 4096: lo que junte el adaptador en una lectura
+};
+
+/**
+ * @brief Nombre de un perfil para la línea de comandos y los reportes
+ */
+const char* nombrePerfil(PerfilSerial perfil);
+
+/**
+ * @brief Bytes por read() de cada perfil (el de volumen lee en bloques grandes)
+ */
+int tamLecturaPerfil(PerfilSerial perfil);
+
+/**
+ * @brief Convierte baudios a la constante de termios
+ * @param baudios Velocidad (ej: 115200, 921600, 3000000)
+ * @param velocidad Salida: constante B<n>
+ * @return false si la velocidad no está soportada
+ */
+bool velocidadTermios(int baudios, speed_t* velocidad);
+
+/**
+ * @brief Activa o desactiva ASYNC_LOW_LATENCY en el driver del puerto
+ * 
+ * En adaptadores USB (ftdi_sio y similares) baja el temporizador de
+ * latencia del adaptador de 16 ms a 1 ms.
+ * 
+ * @return false si el driver no lo soporta (pty, adaptadores sin TIOCSSERIAL)
+ */
+bool configurarBajaLatencia(int fd, bool activar);
+
+/**
+ * @brief Configura el puerto serial para comunicación con ESP32
+ * @param portName Nombre del puerto (ej: /dev/ttyUSB0)
+ * @param baudios Velocidad (ver velocidadTermios)
+ * @param perfil Perfil de lectura
+ * @param bajaLatencia Salida: true si el driver aceptó ASYNC_LOW_LATENCY (puede ser nullptr)
+ * @return File descriptor del puerto abierto, -1 si falla
+ */
+int configurarPuertoSerial(const char* portName, int baudios, PerfilSerial perfil, bool* bajaLatencia);
+
+#endif // PUERTOSERIAL_H
@@ -0,0 +1,162 @@
+/**
+ * @file ResincronizadorPRT7.h
+ * @brief Resincronización a mitad de flujo con salida provisional
+ * 
+ * Al conectarse a un emisor que ya está transmitiendo, el receptor no
+ * conoce las rotaciones (tramas MAP) que se perdieron antes de la
+ * conexión. En vez de descartar la primera secuencia, se decodifica de
+ * inmediato suponiendo el rotor en 'A' y el resultado se marca como
+ * provisional. Las tramas crudas se guardan y, cuando llega la primera
+ * secuencia completa, se confirman o se recalculan con el desplazamiento
+ * correcto.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef RESINCRONIZADORPRT7_H
+#define RESINCRONIZADORPRT7_H
+
+#include <cstddef>
+#include "prt7_api.h"
+
+class BufferDeTramas;
+
+/**
+ * @class ResincronizadorPRT7
+ * @brief Confirma o recalcula la secuencia parcial recibida al conectarse
+ * 
+ * El emisor repite siempre el mismo guion de tramas, así que la
+ * secuencia parcial es un sufijo de cualquier secuencia completa. La
+ * suma de las rotaciones del guion antes de ese sufijo es el
+ * desplazamiento que tenía el rotor al conectarse.
+ * 
+ * Uso: registrarLinea() con cada línea de trama mientras
+ * estaSincronizado() sea falso, y cerrarSecuencia() en cada marcador
+ * "REINICIANDO SECUENCIA".
+ */
+class PRT7_API ResincronizadorPRT7 {
+public:
+    /**
+     * @brief Fase de la resincronización
+     */
+    enum Estado {
+        PROVISIONAL,   ///< Decodificando la secuencia parcial (desplazamiento supuesto 0)
+        CAPTURANDO,    ///< Guardando la primera secuencia completa como referencia
+        SINCRONIZADO   ///< La secuencia parcial ya fue verificada
+    };
+    
+    /**
+     * @brief Resultado de verificar la secuencia parcial
+     */
+    enum Veredicto {
+        PENDIENTE,       ///< Aún no hay secuencia de referencia
+        CONFIRMADO,      ///< La salida provisional era correcta
+        CORREGIDO,       ///< Se recalculó con otro desplazamiento inicial
+        NO_VERIFICABLE   ///< La secuencia parcial no es sufijo de la referencia
+    };
+
+private:
+    Estado estado;                ///< Fase actual
+    Veredicto veredicto;          ///< Resultado de la verificación
+    
+    BufferDeTramas* parcial;      ///< Tramas crudas de la secuencia parcial
+    BufferDeTramas* referencia;   ///< Tramas crudas de la primera secuencia completa
+    
+    char* corregido;              ///< Mensaje recalculado
+    std::size_t longCorregido;    ///< Longitud del mensaje recalculado
+    
+    int desplazamientoInicial;    ///< Desplazamiento del rotor al conectarse
+    
+    /**
+     * @brief Busca la secuencia parcial como sufijo de la referencia
+     * @return Desplazamiento inicial (0-26) o -1 si no coincide
+     */
+    int alinear() const;
+    
+    /**
+     * @brief Verifica la secuencia parcial contra la referencia
+     */
+    void verificar();
+    
+    // No copiable: es dueño de los buffers
+    ResincronizadorPRT7(const ResincronizadorPRT7&);
+    ResincronizadorPRT7& operator=(const ResincronizadorPRT7&);
+
+public:
+    /**
+     * @brief Constructor (empieza en PROVISIONAL)
+     */
+    ResincronizadorPRT7();
+    
+    /**
+     * @brief Destructor
+     * 
+     * Libera los buffers de tramas y de mensajes.
+     */
+    ~ResincronizadorPRT7();
+    
+    /**
+     * @brief Guarda una línea de trama cruda (sin salto de línea)
+     * 
+     * No hace nada una vez sincronizado.
+     * 
+     * @param linea Texto de la trama (ej. "L,A" o "M,-2")
+     * @param longitud Número de bytes
+     */
+    void registrarLinea(const char* linea, std::size_t longitud);
+    
+    /**
+     * @brief Procesa un marcador de reinicio de secuencia
+     * 
+     * En PROVISIONAL pasa a CAPTURANDO; en CAPTURANDO verifica la
+     * secuencia parcial y pasa a SINCRONIZADO. La salida provisional y
+     * la corregida se recalculan de las tramas guardadas, así que la
+     * comparación no depende de cuánto del mensaje conserve la sesión.
+     * 
+     * @return Veredicto (PENDIENTE hasta tener referencia)
+     */
+    Veredicto cerrarSecuencia();
+    
+    /**
+     * @brief Reinicia la resincronización (ej. tras una reconexión)
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Obtiene la fase actual
+     */
+    Estado obtenerEstado() const;
+    
+    /**
+     * @brief Verifica si la salida actual es provisional
+     */
+    bool esProvisional() const;
+    
+    /**
+     * @brief Verifica si la secuencia parcial ya fue verificada
+     */
+    bool estaSincronizado() const;
+    
+    /**
+     * @brief Obtiene el veredicto de la verificación
+     */
+    Veredicto obtenerVeredicto() const;
+    
+    /**
+     * @brief Obtiene el desplazamiento del rotor al conectarse (-1 si no se conoce)
+     */
+    int obtenerDesplazamientoInicial() const;
+    
+    /**
+     * @brief Obtiene el mensaje recalculado (no terminado en '\\0')
+     */
+    const char* obtenerCorregido() const;
+    
+    /**
+     * @brief Obtiene la longitud del mensaje recalculado
+     */
+    std::size_t obtenerLongCorregido() const;
+};
+
+#endif // RESINCRONIZADORPRT7_H
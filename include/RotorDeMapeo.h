@@ -6,6 +6,11 @@
  * "disco de cifrado" similar a una Rueda de César. Puede rotar
  * para cambiar el mapeo de caracteres.
  * 
+ * Concurrencia: los nodos no cambian después del constructor; solo se
+ * mueve la cabeza, que se publica de forma atómica. Un hilo escritor
+ * puede llamar a rotar() mientras otros hilos leen (getMapeo,
+ * getPosicionActual, vuelta) sin bloqueos de ningún lado.
+ * 
  * @author Arturo
  * @date 2025-11-06
  */
@@ -13,6 +18,10 @@
 #ifndef ROTORDEMAPEO_H
 #define ROTORDEMAPEO_H
 
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
 /**
  * @struct NodoRotor
  * @brief Nodo de la lista circular doblemente enlazada
@@ -42,8 +51,8 @@ struct NodoRotor {
  */
 class RotorDeMapeo {
 private:
-    NodoRotor* cabeza;  ///< Puntero a la posición 'cero' actual del rotor
-    int tamanio;        ///< Número de elementos en el rotor
+    std::atomic<NodoRotor*> cabeza;  ///< Posición 'cero' actual (publicada atómicamente)
+    int tamanio;                     ///< Número de elementos en el rotor
     
     /**
      * @brief Encuentra un nodo por su carácter
@@ -60,7 +69,78 @@ private:
      */
     int calcularDistancia(NodoRotor* desde, NodoRotor* hasta) const;
     
+    // No copiable: es dueño de los nodos
+    RotorDeMapeo(const RotorDeMapeo&);
+    RotorDeMapeo& operator=(const RotorDeMapeo&);
+    
 public:
+    /**
+     * @class Iterador
+     * @brief Iterador circular bidireccional de solo lectura sobre el rotor
+     * 
+     * Avanza y retrocede indefinidamente siguiendo los enlaces circulares.
+     * Además del nodo, cuenta los pasos dados desde la cabeza para que
+     * begin()/end() delimiten exactamente una vuelta completa. Dos
+     * iteradores se comparan por sus pasos, así que solo deben compararse
+     * iteradores del mismo recorrido.
+     * 
+     * end() apunta otra vez a la cabeza con pasos = tamaño, así que
+     * --end(), std::prev y std::reverse_iterator llegan al último nodo.
+     * Si otro hilo puede rotar el rotor, el recorrido debe salir de
+     * vuelta(): begin() y end() por separado leen la cabeza dos veces.
+     */
+    class Iterador {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef char value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const char* pointer;
+        typedef const char& reference;
+        
+        Iterador() : nodo(nullptr), pasos(0) {}
+        
+        /**
+         * @brief Constructor
+         * @param n Nodo actual
+         * @param p Pasos dados desde la cabeza
+         */
+        Iterador(const NodoRotor* n, difference_type p) : nodo(n), pasos(p) {}
+        
+        reference operator*() const { return nodo->dato; }
+        pointer operator->() const { return &nodo->dato; }
+        
+        Iterador& operator++() {
+            nodo = nodo->siguiente;
+            pasos++;
+            return *this;
+        }
+        
+        Iterador operator++(int) {
+            Iterador copia = *this;
+            ++(*this);
+            return copia;
+        }
+        
+        Iterador& operator--() {
+            nodo = nodo->previo;
+            pasos--;
+            return *this;
+        }
+        
+        Iterador operator--(int) {
+            Iterador copia = *this;
+            --(*this);
+            return copia;
+        }
+        
+        bool operator==(const Iterador& otro) const { return pasos == otro.pasos; }
+        bool operator!=(const Iterador& otro) const { return !(*this == otro); }
+        
+    private:
+        const NodoRotor* nodo;  ///< Nodo actual
+        difference_type pasos;  ///< Pasos recorridos desde la cabeza
+    };
+    
     /**
      * @brief Constructor
      * 
@@ -79,7 +159,8 @@ public:
      * @brief Rota el rotor N posiciones
      * 
      * Mueve la cabeza del rotor N posiciones hacia adelante (positivo)
-     * o hacia atrás (negativo).
+     * o hacia atrás (negativo). La nueva cabeza se calcula en local
+     * y se publica con una sola escritura atómica (solo un hilo escritor).
      * 
      * @param n Número de posiciones a rotar
      */
@@ -100,6 +181,50 @@ public:
      * @return Carácter en la posición 'cero' del rotor
      */
     char getPosicionActual() const;
+    
+    /**
+     * @brief Regresa la cabeza a 'A' (estado inicial)
+     */
+    void reiniciar();
+    
+    /**
+     * @class Vuelta
+     * @brief Una vuelta completa del rotor a partir de una sola lectura de la cabeza
+     * 
+     * begin() y end() comparten la misma cabeza: el recorrido es una
+     * instantánea consistente aunque otro hilo esté rotando el rotor.
+     */
+    class Vuelta {
+    public:
+        /**
+         * @brief Constructor
+         * @param c Cabeza leída una sola vez
+         * @param t Número de elementos del rotor
+         */
+        Vuelta(const NodoRotor* c, int t) : cabeza(c), tamanio(t) {}
+        
+        Iterador begin() const { return Iterador(cabeza, 0); }
+        Iterador end() const { return Iterador(cabeza, tamanio); }
+        
+    private:
+        const NodoRotor* cabeza;  ///< Cabeza de la instantánea
+        int tamanio;              ///< Elementos del rotor
+    };
+    
+    /**
+     * @brief Vuelta completa desde la posición 'cero' actual (una sola lectura atómica)
+     */
+    Vuelta vuelta() const { return Vuelta(cabeza.load(std::memory_order_acquire), tamanio); }
+    
+    /**
+     * @brief Iterador a la posición 'cero' actual del rotor
+     */
+    Iterador begin() const { return vuelta().begin(); }
+    
+    /**
+     * @brief Iterador una vuelta completa después de la cabeza (otra vez sobre la cabeza)
+     */
+    Iterador end() const { return vuelta().end(); }
 };
 
 #endif // ROTORDEMAPEO_H
@@ -0,0 +1,185 @@
+/**
+ * @file ServidorPRT7.h
+ * @brief Servidor de ingesta PRT-7 por socket local (UNIX o TCP en localhost)
+ * 
+ * Acepta flujos de texto PRT-7 de muchos productores a la vez y los
+ * multiplexa con epoll en un solo hilo. Cada conexión tiene su propia
+ * SesionPRT7 (el mismo parser de tramas que la biblioteca) y recibe
+ * por la misma conexión el mensaje decodificado de cada secuencia.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef SERVIDORPRT7_H
+#define SERVIDORPRT7_H
+
+#include <cstddef>
+#include <atomic>
+
+class SesionPRT7;
+class ServidorPRT7;
+struct EventoPRT7;
+
+/**
+ * @struct SesionConexion
+ * @brief Estado de decodificación de una conexión
+ */
+struct SesionConexion {
+    int fd;                  ///< Socket de la conexión
+    ServidorPRT7* servidor;  ///< Servidor que atiende la conexión (contadores)
+    SesionPRT7* sesion;      ///< Decodificador de la conexión
+    char* salida;            ///< Respuestas pendientes de enviar
+    std::size_t longSalida;  ///< Bytes pendientes en salida
+    std::size_t capSalida;   ///< Capacidad de salida
+    bool finEntrada;         ///< El cliente cerró su lado de escritura
+    unsigned int eventos;    ///< Eventos registrados en epoll para la conexión
+    
+    /**
+     * @brief Constructor
+     * @param f Socket de la conexión
+     * @param srv Servidor que atiende la conexión
+     */
+    SesionConexion(int f, ServidorPRT7* srv);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Libera las estructuras de la sesión (no cierra el socket).
+     */
+    ~SesionConexion();
+    
+    /**
+     * @brief Agrega bytes a la salida pendiente
+     */
+    void agregarSalida(const char* datos, std::size_t longitud);
+    
+private:
+    // No copiable
+    SesionConexion(const SesionConexion&);
+    SesionConexion& operator=(const SesionConexion&);
+};
+
+/**
+ * @class ServidorPRT7
+ * @brief Bucle epoll que atiende muchas conexiones PRT-7 concurrentes
+ * 
+ * Protocolo: el cliente envía líneas PRT-7 (L,X / M,N / REINICIANDO
+ * SECUENCIA). Al final de cada secuencia (marcador de reinicio o cierre
+ * de escritura del cliente) el servidor responde con el mensaje
+ * decodificado seguido de '\\n'.
+ * 
+ * Si un cliente no lee sus respuestas, la conexión deja de leerse
+ * (sin EPOLLIN) en cuanto tiene LIMITE_SALIDA bytes pendientes y se
+ * reanuda cuando se vacían: la memoria por conexión queda acotada.
+ */
+class ServidorPRT7 {
+public:
+    static const std::size_t LIMITE_SALIDA = 65536;  ///< Bytes pendientes que pausan la lectura
+    
+private:
+    int epollFd;              ///< Descriptor de epoll
+    int escuchaFd;            ///< Socket de escucha
+    int despertarFd;          ///< eventfd para detener() desde otro hilo
+    int reservaFd;            ///< Descriptor de reserva para rechazar conexiones sin descriptores libres
+    char rutaUnix[108];       ///< Ruta del socket UNIX (para borrarla al cerrar)
+    
+    SesionConexion** sesiones;  ///< Tabla de sesiones indexada por fd
+    int capSesiones;            ///< Tamaño de la tabla
+    int numRotores;             ///< Rotores de la SesionPRT7 de cada conexión
+    
+    std::atomic<bool> detenido;  ///< Solicitud de detener ejecutar()
+    
+    unsigned long long conexionesTotales;   ///< Conexiones aceptadas
+    unsigned long long conexionesRechazadas; ///< Conexiones cerradas por falta de descriptores
+    int conexionesActivas;                  ///< Conexiones abiertas
+    unsigned long long tramasProcesadas;    ///< Tramas decodificadas
+    unsigned long long mensajesEnviados;    ///< Mensajes respondidos
+    
+    bool prepararEscucha(int fd);
+    void aceptarConexiones();
+    void atenderLectura(SesionConexion* s);
+    bool enviarPendiente(SesionConexion* s);
+    void actualizarEventos(SesionConexion* s);
+    void cerrarSesion(SesionConexion* s);
+    void registrarSesion(SesionConexion* s);
+    
+    static void alEvento(const EventoPRT7* evento, void* contexto);
+    friend struct SesionConexion;  // Crea su SesionPRT7 con alEvento
+    
+    // No copiable
+    ServidorPRT7(const ServidorPRT7&);
+    ServidorPRT7& operator=(const ServidorPRT7&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param rotores Número de rotores de cada conexión (1 = protocolo original)
+     */
+    explicit ServidorPRT7(int rotores = 1);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Cierra todas las conexiones y el socket de escucha.
+     */
+    ~ServidorPRT7();
+    
+    /**
+     * @brief Escucha en un socket UNIX (SOCK_STREAM)
+     * @param ruta Ruta del socket (se reemplaza si ya existe)
+     * @return true si se pudo escuchar
+     */
+    bool escucharUnix(const char* ruta);
+    
+    /**
+     * @brief Escucha en TCP, solo en 127.0.0.1
+     * @param puerto Puerto TCP (0 = elegido por el sistema)
+     * @return Puerto real en el que escucha, -1 si falla
+     */
+    int escucharTcp(int puerto);
+    
+    /**
+     * @brief Atiende eventos una vez
+     * @param esperaMs Tiempo máximo de espera (-1 = indefinido)
+     * @return Número de eventos atendidos, -1 si hubo error
+     */
+    int atenderEventos(int esperaMs);
+    
+    /**
+     * @brief Atiende eventos hasta que se llame a detener()
+     */
+    void ejecutar();
+    
+    /**
+     * @brief Solicita que ejecutar() termine (seguro desde otro hilo o señal)
+     */
+    void detener();
+    
+    /**
+     * @brief Obtiene el número de conexiones abiertas
+     */
+    int obtenerConexionesActivas() const;
+    
+    /**
+     * @brief Obtiene el número total de conexiones aceptadas
+     */
+    unsigned long long obtenerConexionesTotales() const;
+    
+    /**
+     * @brief Obtiene el número de conexiones rechazadas por falta de descriptores
+     */
+    unsigned long long obtenerConexionesRechazadas() const;
+    
+    /**
+     * @brief Obtiene el número total de tramas decodificadas
+     */
+    unsigned long long obtenerTramasProcesadas() const;
+    
+    /**
+     * @brief Obtiene el número de mensajes respondidos
+     */
+    unsigned long long obtenerMensajesEnviados() const;
+};
+
+#endif // SERVIDORPRT7_H
@@ -0,0 +1,274 @@
+/**
+ * @file SesionPRT7.h
+ * @brief Sesión de decodificación PRT-7 alimentada por bytes
+ * 
+ * Reúne todo lo que antes vivía en el ciclo del puerto serial de
+ * main.cpp: armado de líneas, detección del marcador de reinicio,
+ * despacho de tramas LOAD/MAP y cierre de secuencias. Quien la usa solo
+ * entrega los bytes tal como llegan (de un puerto, un socket o un
+ * archivo) y recibe eventos ya decodificados, sin procesos ni texto
+ * intermedio que volver a parsear.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef SESIONPRT7_H
+#define SESIONPRT7_H
+
+#include <cstddef>
+#include "prt7_api.h"
+
+class RotorDeMapeo;
+class CascadaDeRotores;
+class ListaDeCarga;
+class DetectorDePalabras;
+class VentanaDeCarga;
+class MensajeEmpaquetado;
+class ResincronizadorPRT7;
+
+/**
+ * @struct EventoPRT7
+ * @brief Resultado de procesar una trama o un marcador de reinicio
+ * 
+ * Solo son válidos los campos del tipo de evento; el resto queda en 0.
+ */
+struct EventoPRT7 {
+    /**
+     * @brief Tipo de evento
+     */
+    enum Tipo {
+        CARGA,             ///< Trama LOAD decodificada
+        MAPEO,             ///< Trama MAP aplicada
+        ERROR_TRAMA,       ///< Trama mal formada o rotor inexistente
+        INICIO_SECUENCIA,  ///< Marcador de reinicio: empieza una secuencia nueva
+        FIN_SECUENCIA      ///< Marcador de reinicio: terminó una secuencia con tramas
+    };
+    
+    /**
+     * @brief Motivo de un ERROR_TRAMA
+     */
+    enum CodigoError {
+        SIN_ERROR,          ///< El evento no es un error
+        LOAD_SIN_DATO,      ///< Trama LOAD sin carácter
+        FORMATO_MAP,        ///< Se esperaba M,<numero> o M<rotor>,<numero>
+        ROTOR_INEXISTENTE   ///< Trama MAP dirigida a un rotor que no existe
+    };
+    
+    Tipo tipo;                    ///< Tipo de evento
+    const char* linea;            ///< Línea de la trama (CARGA, MAPEO, ERROR_TRAMA)
+    char codificado;              ///< CARGA: carácter recibido
+    char decodificado;            ///< CARGA: carácter decodificado
+    int rotacion;                 ///< MAPEO: posiciones rotadas
+    int indiceRotor;              ///< MAPEO y ROTOR_INEXISTENTE: rotor de la trama
+    char mapeoA;                  ///< MAPEO: carácter al que se mapea 'A' después de rotar
+    int numSecuencia;             ///< Número de secuencia (0 = descartando hasta el primer marcador)
+    int tramasSecuencia;          ///< FIN_SECUENCIA: tramas recibidas en la secuencia
+    std::size_t longitudMensaje;  ///< FIN_SECUENCIA: caracteres del mensaje
+    bool provisional;             ///< FIN_SECUENCIA: la secuencia se decodificó sin verificar
+    int veredicto;                ///< FIN_SECUENCIA: ResincronizadorPRT7::Veredicto al cerrarla
+    CodigoError codigoError;      ///< ERROR_TRAMA: motivo
+};
+
+/**
+ * @class SesionPRT7
+ * @brief Decodificador de un flujo PRT-7 con interfaz de eventos
+ * 
+ * Los eventos se entregan de forma síncrona dentro de alimentar(); en
+ * FIN_SECUENCIA la lista todavía contiene el mensaje completo, así que
+ * obtenerCarga() y copiarMensaje() lo devuelven. Una sesión no es
+ * segura entre hilos: cada flujo usa la suya.
+ */
+class PRT7_API SesionPRT7 {
+public:
+    /**
+     * @brief Función llamada con cada evento
+     * @param evento Evento (válido solo durante la llamada)
+     * @param contexto Puntero de usuario
+     */
+    typedef void (*AlEvento)(const EventoPRT7* evento, void* contexto);
+    
+    static const int TAM_LINEA = 256;  ///< Longitud máxima de línea (lo demás se descarta)
+
+private:
+    int numRotores;                 ///< 1 = rotor simple, >1 = cascada
+    RotorDeMapeo* rotor;            ///< Rotor (si numRotores == 1)
+    CascadaDeRotores* cascada;      ///< Cascada (si numRotores > 1)
+    ListaDeCarga* carga;            ///< Mensaje de la secuencia actual
+    
+    AlEvento aviso;                 ///< Función de eventos (puede ser nullptr)
+    void* contexto;                 ///< Contexto de usuario
+    ResincronizadorPRT7* resincronizador;  ///< Verificación de la primera secuencia (no es dueña)
+    
+    char linea[TAM_LINEA];          ///< Línea en armado
+    int longLinea;                  ///< Caracteres en linea
+    
+    bool esperarReinicio;           ///< Descartar tramas hasta el primer marcador
+    bool detenida;                  ///< detener() pidió cortar alimentar()
+    int numSecuencia;               ///< Secuencia actual
+    int tramasSecuencia;            ///< Tramas de la secuencia actual
+    unsigned long long tramasTotales;  ///< Tramas procesadas desde el inicio
+    int errores;                    ///< Tramas mal formadas
+    
+    /**
+     * @brief Procesa una línea completa (trama, marcador u otra)
+     */
+    void procesarLinea();
+    
+    /**
+     * @brief Despacha una trama LOAD/MAP
+     */
+    void procesarTrama();
+    
+    /**
+     * @brief Cierra la secuencia actual y empieza la siguiente
+     */
+    void cerrarSecuencia();
+    
+    /**
+     * @brief Entrega un ERROR_TRAMA
+     */
+    void avisarError(EventoPRT7::CodigoError codigo, int indiceRotor);
+    
+    /**
+     * @brief Entrega un evento si hay función de eventos
+     */
+    void avisar(const EventoPRT7& evento) {
+        if (aviso != nullptr) aviso(&evento, contexto);
+    }
+    
+    // No copiable: es dueña del rotor y de la lista
+    SesionPRT7(const SesionPRT7&);
+    SesionPRT7& operator=(const SesionPRT7&);
+
+public:
+    /**
+     * @brief Constructor
+     * @param rotores Número de rotores (1 = protocolo original; se usa al menos 1)
+     * @param f Función de eventos (nullptr = solo consultar el estado)
+     * @param ctx Contexto de usuario para f
+     */
+    explicit SesionPRT7(int rotores = 1, AlEvento f = nullptr, void* ctx = nullptr);
+    
+    /**
+     * @brief Destructor
+     */
+    ~SesionPRT7();
+    
+    /**
+     * @brief Descarta las tramas hasta el primer marcador de reinicio
+     * 
+     * Es el comportamiento original del receptor: la primera secuencia
+     * puede estar incompleta. Llamar antes de alimentar().
+     * 
+     * @param activo true para esperar el primer marcador
+     */
+    void setEsperarReinicio(bool activo);
+    
+    /**
+     * @brief Asocia un detector de palabras al mensaje decodificado
+     */
+    void setDetector(DetectorDePalabras* d);
+    
+    /**
+     * @brief Guarda el mensaje en una ventana de memoria fija
+     */
+    void setVentana(VentanaDeCarga* v);
+    
+    /**
+     * @brief Guarda el mensaje empaquetado a 5 bits por símbolo
+     */
+    void setEmpaquetado(MensajeEmpaquetado* m);
+    
+    /**
+     * @brief Verifica la primera secuencia con un resincronizador
+     * 
+     * Cada trama se registra mientras no esté sincronizado y cada
+     * marcador cierra su secuencia; el veredicto viaja en FIN_SECUENCIA.
+     * 
+     * @param r Resincronizador (nullptr = sin verificación)
+     */
+    void setResincronizador(ResincronizadorPRT7* r);
+    
+    /**
+     * @brief Entrega bytes recibidos
+     * 
+     * '\\n' y '\\r' terminan una línea; las líneas vacías se ignoran. Una
+     * línea incompleta queda pendiente para la siguiente llamada.
+     * 
+     * @param datos Bytes recibidos
+     * @param longitud Número de bytes
+     * @return Bytes consumidos (menos que longitud si un evento llamó a detener())
+     */
+    std::size_t alimentar(const char* datos, std::size_t longitud);
+    
+    /**
+     * @brief Procesa la línea pendiente como si terminara en '\\n' (fin del flujo)
+     */
+    void finalizar();
+    
+    /**
+     * @brief Corta el alimentar() en curso después del evento actual
+     * 
+     * Pensado para llamarse desde la función de eventos; el siguiente
+     * alimentar() continúa con normalidad.
+     */
+    void detener();
+    
+    /**
+     * @brief Vuelve al estado inicial
+     * 
+     * Descarta la línea pendiente y el mensaje, reinicia el rotor, los
+     * contadores y el resincronizador asociado.
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Obtiene la lista con el mensaje de la secuencia actual
+     */
+    const ListaDeCarga* obtenerCarga() const;
+    
+    /**
+     * @brief Copia el mensaje decodificado de la secuencia actual
+     * 
+     * Con ventana y sin segmento solo quedan los últimos caracteres:
+     * ListaDeCarga::obtenerCopiables() dice cuántos se pueden copiar.
+     * 
+     * @param buffer Buffer de destino (se termina en '\0')
+     * @param capacidad Tamaño del buffer en bytes
+     * @return Número de caracteres copiados
+     */
+    std::size_t copiarMensaje(char* buffer, std::size_t capacidad) const;
+    
+    /**
+     * @brief Obtiene cómo se decodifica un carácter con el rotor actual
+     */
+    char obtenerMapeo(char c) const;
+    
+    /**
+     * @brief Obtiene el número de rotores
+     */
+    int obtenerNumRotores() const;
+    
+    /**
+     * @brief Obtiene el número de la secuencia actual (0 = esperando el primer marcador)
+     */
+    int obtenerNumSecuencia() const;
+    
+    /**
+     * @brief Obtiene las tramas recibidas en la secuencia actual
+     */
+    int obtenerTramasSecuencia() const;
+    
+    /**
+     * @brief Obtiene las tramas procesadas desde el inicio
+     */
+    unsigned long long obtenerTramasTotales() const;
+    
+    /**
+     * @brief Obtiene el número de tramas mal formadas
+     */
+    int obtenerErrores() const;
+};
+
+#endif // SESIONPRT7_H
@@ -15,6 +15,7 @@
 // Forward declarations
 class ListaDeCarga;
 class RotorDeMapeo;
+class CascadaDeRotores;
 
 /**
  * @class TramaBase
@@ -46,6 +47,20 @@ public:
      * @param rotor Puntero al rotor de mapeo para decodificación
      */
     virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
+    
+    /**
+     * @brief Procesa la trama sobre una cascada de varios rotores
+     * 
+     * Por defecto no hace nada; las tramas que entienden la cascada
+     * (LOAD y MAP) lo sobrescriben.
+     * 
+     * @param carga Puntero a la lista donde se almacenan los datos decodificados
+     * @param cascada Puntero a la cascada de rotores
+     */
+    virtual void procesarEnCascada(ListaDeCarga* carga, CascadaDeRotores* cascada) {
+        (void)carga;
+        (void)cascada;
+    }
 };
 
 #endif // TRAMABASE_H
@@ -26,6 +26,7 @@
 class TramaLoad : public TramaBase {
 private:
     char dato; ///< Carácter a decodificar
+    char resultado; ///< Carácter decodificado por el último procesar()
     
 public:
     /**
@@ -48,6 +49,22 @@ public:
      * @param rotor Puntero al rotor de mapeo para decodificación
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Procesa la trama LOAD sobre una cascada de rotores
+     * 
+     * Decodifica el carácter con la tabla compuesta de la cascada.
+     * 
+     * @param carga Puntero a la lista donde se almacenará el dato decodificado
+     * @param cascada Puntero a la cascada de rotores
+     */
+    void procesarEnCascada(ListaDeCarga* carga, CascadaDeRotores* cascada) override;
+    
+    /**
+     * @brief Obtiene el carácter decodificado por el último procesamiento
+     * @return Carácter decodificado ('\0' si aún no se procesó)
+     */
+    char getResultado() const;
 };
 
 #endif // TRAMALOAD_H
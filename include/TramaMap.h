@@ -21,18 +21,23 @@
  * Esta trama contiene un valor de rotación que modifica el estado
  * del rotor, cambiando la forma en que se decodifican los caracteres.
  * 
- * Formato: M,N donde N es un entero (positivo o negativo)
+ * Formato: M,N donde N es un entero (positivo o negativo).
+ * En una cascada de rotores: Mk,N rota el rotor de índice k
+ * (M,N equivale a M0,N).
  */
 class TramaMap : public TramaBase {
 private:
-    int rotacion; ///< Valor de rotación (positivo o negativo)
+    int rotacion;     ///< Valor de rotación (positivo o negativo)
+    int indiceRotor;  ///< Rotor al que se dirige la trama (0 = primero)
+    bool aplicada;    ///< false si el último procesar() no encontró el rotor
     
 public:
     /**
      * @brief Constructor
      * @param n Valor de rotación a aplicar
+     * @param indice Índice del rotor a rotar (0 por defecto)
      */
-    TramaMap(int n);
+    TramaMap(int n, int indice = 0);
     
     /**
      * @brief Destructor
@@ -49,6 +54,22 @@ public:
      * @param rotor Puntero al rotor que será rotado
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Procesa la trama MAP sobre una cascada de rotores
+     * 
+     * Rota el rotor indicado por indiceRotor.
+     * 
+     * @param carga Puntero a la lista de carga (no usado en MAP)
+     * @param cascada Puntero a la cascada de rotores
+     */
+    void procesarEnCascada(ListaDeCarga* carga, CascadaDeRotores* cascada) override;
+    
+    /**
+     * @brief Verifica si el último procesamiento aplicó la rotación
+     * @return false si el rotor indicado no existe
+     */
+    bool fueAplicada() const;
 };
 
 #endif // TRAMAMAP_H
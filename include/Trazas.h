@@ -0,0 +1,65 @@
+/**
+ * @file Trazas.h
+ * @brief Puntos de traza con alcance, activados en tiempo de compilación
+ * 
+ * Con la opción de CMake PRT7_TRAZAS=ON, cada PRT7_TRAZA("nombre") mide
+ * el tiempo de su bloque con el reloj monotónico y lo guarda en un
+ * buffer circular propio de cada hilo. Al salir del programa (o al
+ * recibir SIGUSR2) los eventos se vuelcan en formato JSON de Chrome
+ * (chrome://tracing, Perfetto) al archivo indicado por la variable de
+ * entorno PRT7_TRAZA_ARCHIVO (por defecto prt7_traza.json).
+ * 
+ * Sin PRT7_TRAZAS la macro no genera código.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef TRAZAS_H
+#define TRAZAS_H
+
+#ifdef PRT7_TRAZAS
+
+/**
+ * @class PuntoDeTraza
+ * @brief Registra un evento de duración desde su construcción hasta su destrucción
+ */
+class PuntoDeTraza {
+private:
+    const char* nombre;          ///< Nombre del evento (cadena literal)
+    unsigned long long inicioNs; ///< Momento de inicio
+    
+public:
+    /**
+     * @brief Constructor: marca el inicio del evento
+     * @param n Nombre del evento (debe ser una cadena literal)
+     */
+    explicit PuntoDeTraza(const char* n);
+    
+    /**
+     * @brief Destructor: guarda el evento en el buffer del hilo
+     */
+    ~PuntoDeTraza();
+};
+
+/**
+ * @brief Vuelca todos los eventos registrados como JSON de Chrome
+ * 
+ * Solo usa funciones seguras en manejadores de señales (open/write).
+ * 
+ * @param ruta Archivo de salida
+ * @return true si se pudo escribir
+ */
+bool volcarTrazas(const char* ruta);
+
+#define PRT7_TRAZA_UNIR2(a, b) a##b
+#define PRT7_TRAZA_UNIR(a, b) PRT7_TRAZA_UNIR2(a, b)
+#define PRT7_TRAZA(nombre) PuntoDeTraza PRT7_TRAZA_UNIR(puntoDeTraza_, __LINE__)(nombre)
+
+#else
+
+#define PRT7_TRAZA(nombre) do { } while (0)
+
+#endif // PRT7_TRAZAS
+
+#endif // TRAZAS_H
@@ -0,0 +1,174 @@
+/**
+ * @file VentanaDeCarga.h
+ * @brief Ventana deslizante de memoria fija con derrame a disco
+ * 
+ * Si el emisor nunca envía el marcador de reinicio, la ListaDeCarga
+ * crece sin límite (un NodoCarga por carácter). En modo ventana solo se
+ * guardan en memoria los últimos N caracteres decodificados, en un
+ * anillo fijo; los bloques más antiguos se agregan a un archivo de
+ * segmento (solo escritura al final) que se puede mapear con mmap para
+ * consultarlo.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef VENTANADECARGA_H
+#define VENTANADECARGA_H
+
+#include <cstddef>
+#include "prt7_api.h"
+
+/**
+ * @class VentanaDeCarga
+ * @brief Anillo de caracteres decodificados con segmento en disco
+ * 
+ * La capacidad se redondea a un múltiplo de TAM_BLOQUE y el inicio del
+ * anillo siempre está alineado a un bloque, así que cada derrame es una
+ * sola escritura contigua de TAM_BLOQUE bytes. La memoria usada no
+ * depende de la longitud del flujo.
+ * 
+ * Las posiciones de leer() son relativas al inicio de la secuencia
+ * actual: primero la parte en disco y después la que está en el anillo.
+ */
+class PRT7_API VentanaDeCarga {
+public:
+    static const std::size_t TAM_BLOQUE = 4096;  ///< Bytes por derrame
+
+private:
+    char* anillo;                 ///< Últimos caracteres de la secuencia
+    std::size_t capacidad;        ///< Tamaño del anillo (múltiplo de TAM_BLOQUE)
+    std::size_t inicio;           ///< Índice del carácter más antiguo en el anillo
+    std::size_t cantidad;         ///< Caracteres en el anillo
+    
+    int fdSegmento;               ///< Archivo de segmento (-1 = sin disco)
+    std::size_t longSegmento;     ///< Bytes escritos en el segmento
+    std::size_t inicioSecuencia;  ///< Posición del segmento donde empieza la secuencia
+    std::size_t derramados;       ///< Caracteres de la secuencia que salieron del anillo
+    std::size_t descartados;      ///< Caracteres que no se pudieron escribir a disco
+    
+    mutable const char* mapa;     ///< Segmento mapeado con mmap (nullptr = sin mapear)
+    mutable std::size_t longMapa; ///< Bytes mapeados
+    
+    /**
+     * @brief Escribe el bloque más antiguo del anillo al segmento
+     */
+    void derramarBloque();
+    
+    /**
+     * @brief Libera el mapeo actual del segmento
+     */
+    void desmapear() const;
+    
+    // No copiable: es dueña del anillo y del archivo
+    VentanaDeCarga(const VentanaDeCarga&);
+    VentanaDeCarga& operator=(const VentanaDeCarga&);
+
+public:
+    /**
+     * @brief Constructor
+     * 
+     * Abre (o crea) el segmento en modo de solo agregar; el contenido
+     * previo se conserva y la primera secuencia empieza al final.
+     * 
+     * @param capacidadVentana Caracteres que se guardan en memoria
+     * @param rutaSegmento Archivo de segmento (nullptr = descartar lo antiguo)
+     */
+    VentanaDeCarga(std::size_t capacidadVentana, const char* rutaSegmento);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Libera el anillo, el mapeo y cierra el segmento.
+     */
+    ~VentanaDeCarga();
+    
+    /**
+     * @brief Verifica si hay segmento en disco
+     * @return false si no se pidió o no se pudo abrir
+     */
+    bool tieneSegmento() const;
+    
+    /**
+     * @brief Obtiene la capacidad efectiva del anillo
+     * @return Caracteres en memoria (la capacidad pedida redondeada a TAM_BLOQUE)
+     */
+    std::size_t obtenerCapacidad() const;
+    
+    /**
+     * @brief Agrega un carácter decodificado al final de la ventana
+     * 
+     * Si el anillo está lleno, primero derrama su bloque más antiguo.
+     * 
+     * @param c Carácter decodificado
+     */
+    void agregar(char c) {
+        if (cantidad == capacidad) derramarBloque();
+        std::size_t pos = inicio + cantidad;
+        if (pos >= capacidad) pos -= capacidad;
+        anillo[pos] = c;
+        cantidad++;
+    }
+    
+    /**
+     * @brief Comienza una nueva secuencia
+     * 
+     * Vacía el anillo; lo ya derramado queda en el segmento.
+     */
+    void vaciar();
+    
+    /**
+     * @brief Obtiene el número total de caracteres de la secuencia actual
+     */
+    std::size_t obtenerTamanio() const;
+    
+    /**
+     * @brief Obtiene el número de caracteres en memoria
+     */
+    std::size_t obtenerEnMemoria() const;
+    
+    /**
+     * @brief Obtiene el número de caracteres de la secuencia que están en disco
+     */
+    std::size_t obtenerEnDisco() const;
+    
+    /**
+     * @brief Obtiene el número de caracteres perdidos (sin segmento o error de escritura)
+     */
+    std::size_t obtenerDescartados() const;
+    
+    /**
+     * @brief Copia el contenido del anillo (los últimos caracteres)
+     * 
+     * Escribe como máximo capacidad - 1 caracteres y termina en '\0'.
+     * 
+     * @param buffer Buffer de destino
+     * @param capacidadBuffer Tamaño del buffer en bytes
+     * @return Número de caracteres copiados
+     */
+    std::size_t copiarVentana(char* buffer, std::size_t capacidadBuffer) const;
+    
+    /**
+     * @brief Mapea el segmento completo en memoria (solo lectura)
+     * 
+     * El mapeo se rehace si el segmento creció desde la última llamada.
+     * 
+     * @param longitud Salida: bytes mapeados
+     * @return Puntero al segmento o nullptr si está vacío o no hay segmento
+     */
+    const char* mapearSegmento(std::size_t* longitud) const;
+    
+    /**
+     * @brief Lee caracteres de la secuencia actual por posición
+     * 
+     * La parte en disco se lee a través del mapeo del segmento.
+     * 
+     * @param posicion Posición desde el inicio de la secuencia
+     * @param destino Buffer de destino (no se termina en '\0')
+     * @param n Número de caracteres a leer
+     * @return Número de caracteres leídos
+     */
+    std::size_t leer(std::size_t posicion, char* destino, std::size_t n) const;
+};
+
+#endif // VENTANADECARGA_H
@@ -0,0 +1,156 @@
+/**
+ * @file prt7.h
+ * @brief Interfaz en C de libprt7 (sesiones de decodificación PRT-7)
+ * 
+ * Envoltura de SesionPRT7 para usar la biblioteca desde C o desde otros
+ * lenguajes por FFI: un manejador opaco por flujo, bytes de entrada y
+ * eventos de salida. Ninguna función deja escapar excepciones: las que
+ * reservan memoria o llaman a la función de eventos las atrapan y
+ * devuelven un código de error.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef PRT7_H
+#define PRT7_H
+
+#include <stddef.h>
+#include "prt7_api.h"
+
+/**
+ * @brief Valor de error de prt7_alimentar
+ */
+#define PRT7_ERROR ((size_t)-1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sesión de decodificación (opaca)
+ */
+typedef struct prt7_sesion prt7_sesion;
+
+/**
+ * @brief Tipos de evento (mismos valores que EventoPRT7::Tipo)
+ */
+enum prt7_tipo_evento {
+    PRT7_CARGA = 0,             /**< Trama LOAD decodificada */
+    PRT7_MAPEO = 1,             /**< Trama MAP aplicada */
+    PRT7_ERROR_TRAMA = 2,       /**< Trama mal formada o rotor inexistente */
+    PRT7_INICIO_SECUENCIA = 3,  /**< Empieza una secuencia nueva */
+    PRT7_FIN_SECUENCIA = 4      /**< Terminó una secuencia con tramas */
+};
+
+/**
+ * @brief Evento de decodificación (ver EventoPRT7)
+ */
+typedef struct prt7_evento {
+    int tipo;                   /**< prt7_tipo_evento */
+    const char* linea;          /**< Línea de la trama (CARGA, MAPEO, ERROR_TRAMA) */
+    char codificado;            /**< CARGA: carácter recibido */
+    char decodificado;          /**< CARGA: carácter decodificado */
+    int rotacion;               /**< MAPEO: posiciones rotadas */
+    int indice_rotor;           /**< MAPEO: rotor de la trama */
+    char mapeo_a;               /**< MAPEO: carácter al que se mapea 'A' */
+    int num_secuencia;          /**< Número de secuencia */
+    int tramas_secuencia;       /**< FIN_SECUENCIA: tramas de la secuencia */
+    size_t longitud_mensaje;    /**< FIN_SECUENCIA: caracteres del mensaje */
+    int provisional;            /**< FIN_SECUENCIA: 1 si no estaba verificada */
+    int veredicto;              /**< FIN_SECUENCIA: veredicto del resincronizador */
+    int codigo_error;           /**< ERROR_TRAMA: EventoPRT7::CodigoError */
+} prt7_evento;
+
+/**
+ * @brief Función llamada con cada evento (el evento solo es válido durante la llamada)
+ */
+typedef void (*prt7_al_evento)(const prt7_evento* evento, void* contexto);
+
+/**
+ * @brief Versión de la biblioteca ("MAYOR.MENOR.PARCHE")
+ */
+PRT7_API const char* prt7_version(void);
+
+/**
+ * @brief Crea una sesión
+ * @param num_rotores Número de rotores (1 = protocolo original)
+ * @param al_evento Función de eventos (NULL = solo consultar el estado)
+ * @param contexto Puntero de usuario para al_evento
+ * @param esperar_reinicio Distinto de 0 para descartar hasta el primer marcador
+ * @return Sesión o NULL si no hay memoria
+ */
+PRT7_API prt7_sesion* prt7_crear(int num_rotores, prt7_al_evento al_evento, void* contexto,
+                                 int esperar_reinicio);
+
+/**
+ * @brief Destruye una sesión (acepta NULL)
+ */
+PRT7_API void prt7_destruir(prt7_sesion* sesion);
+
+/**
+ * @brief Entrega bytes recibidos; los eventos se entregan antes de volver
+ * 
+ * Si falta memoria la secuencia actual puede quedar incompleta; la
+ * sesión sigue siendo válida y prt7_reiniciar la deja como nueva.
+ * 
+ * @return Bytes consumidos (menos que longitud si se llamó a
+ *         prt7_detener) o PRT7_ERROR si falta memoria
+ */
+PRT7_API size_t prt7_alimentar(prt7_sesion* sesion, const char* datos, size_t longitud);
+
+/**
+ * @brief Procesa la línea pendiente (fin del flujo)
+ * @return 0 o -1 si falta memoria
+ */
+PRT7_API int prt7_finalizar(prt7_sesion* sesion);
+
+/**
+ * @brief Corta el prt7_alimentar en curso (llamar desde la función de eventos)
+ */
+PRT7_API void prt7_detener(prt7_sesion* sesion);
+
+/**
+ * @brief Vuelve la sesión a su estado inicial
+ * @return 0 o -1 si falta memoria (se puede volver a intentar)
+ */
+PRT7_API int prt7_reiniciar(prt7_sesion* sesion);
+
+/**
+ * @brief Obtiene el número de la secuencia actual
+ */
+PRT7_API int prt7_num_secuencia(const prt7_sesion* sesion);
+
+/**
+ * @brief Obtiene las tramas de la secuencia actual
+ */
+PRT7_API int prt7_tramas_secuencia(const prt7_sesion* sesion);
+
+/**
+ * @brief Obtiene las tramas procesadas desde el inicio
+ */
+PRT7_API unsigned long long prt7_tramas_totales(const prt7_sesion* sesion);
+
+/**
+ * @brief Obtiene el número de tramas mal formadas
+ */
+PRT7_API int prt7_errores(const prt7_sesion* sesion);
+
+/**
+ * @brief Obtiene cómo se decodifica un carácter con el rotor actual
+ */
+PRT7_API char prt7_mapeo(const prt7_sesion* sesion, char c);
+
+/**
+ * @brief Copia el mensaje de la secuencia actual
+ * @param buffer Buffer de destino (se termina en '\\0')
+ * @param capacidad Tamaño del buffer en bytes
+ * @return Número de caracteres copiados (0 si hubo un error)
+ */
+PRT7_API size_t prt7_copiar_mensaje(const prt7_sesion* sesion, char* buffer, size_t capacidad);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRT7_H */
@@ -0,0 +1,27 @@
+/**
+ * @file prt7_api.h
+ * @brief Marca de exportación de libprt7
+ * 
+ * La biblioteca se compila con visibilidad oculta por defecto: solo
+ * quedan en la tabla de símbolos de libprt7.so las funciones y clases
+ * marcadas con PRT7_API. Se puede incluir desde C y desde C++.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#ifndef PRT7_API_H
+#define PRT7_API_H
+
+/**
+ * @brief Marca los símbolos que exporta la biblioteca compartida
+ */
+#ifndef PRT7_API
+#if defined(__GNUC__)
+#define PRT7_API __attribute__((visibility("default")))
+#else
+#define PRT7_API
+#endif
+#endif
+
+#endif // PRT7_API_H
@@ -16,14 +16,25 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
-#include <fstream>
+#include <climits>
 #include <unistd.h>
 #include <fcntl.h>
-#include <termios.h>
-#include "include/TramaLoad.h"
-#include "include/TramaMap.h"
 #include "include/RotorDeMapeo.h"
+#include "include/CascadaDeRotores.h"
 #include "include/ListaDeCarga.h"
+#include "include/BufferDeTramas.h"
+#include "include/EscritorAsincrono.h"
+#include "include/ServidorPRT7.h"
+#include "include/DetectorDePalabras.h"
+#include "include/CodificadorPRT7.h"
+#include "include/MensajeEmpaquetado.h"
+#include "include/ResincronizadorPRT7.h"
+#include "include/VentanaDeCarga.h"
+#include "include/DecodificadorParalelo.h"
+#include "include/SesionPRT7.h"
+#include "include/PuertoSerial.h"
+#include "include/Trazas.h"
+#include <csignal>
 
 /**
  * @brief Compara dos cadenas C-style (case-insensitive)
@@ -40,150 +51,361 @@ bool strcmp_nocase(const char* a, const char* b) {
 }
 
 /**
- * @brief Configura el puerto serial para comunicación con ESP32
- * @param portName Nombre del puerto (ej: /dev/ttyUSB0)
- * @return File descriptor del puerto abierto, -1 si falla
+ * @brief Puerto, velocidad y perfil del modo interactivo
  */
-int configurarPuertoSerial(const char* portName) {
-    int serial_port = open(portName, O_RDONLY | O_NOCTTY);
+struct ConfiguracionSerial {
+    const char* ruta;      ///< Dispositivo (por defecto /dev/ttyUSB0)
+    int baudios;           ///< Velocidad (por defecto 115200)
+    PerfilSerial perfil;   ///< Perfil de lectura (por defecto el clásico)
+};
+
+/**
+ * @brief Aviso de palabra clave detectada durante la decodificación
+ * @param idPatron Índice de la palabra en el arreglo de alertas
+ * @param numSecuencia Número de secuencia
+ * @param desplazamiento Posición de la palabra dentro del mensaje
+ * @param contexto Arreglo de palabras (const char**)
+ */
+void avisarPalabraDetectada(int idPatron, int numSecuencia, int desplazamiento, void* contexto) {
+    const char** palabras = static_cast<const char**>(contexto);
+    std::cout << "[ALERTA] Palabra '" << palabras[idPatron] << "' detectada en secuencia #"
+              << numSecuencia << ", posición " << desplazamiento << std::endl;
+}
+
+/**
+ * @brief Imprime el mensaje de una secuencia terminada (modo por lotes)
+ * @param carga Lista con el mensaje decodificado
+ * @param contexto Puntero a un int con el número de secuencia
+ */
+void imprimirSecuenciaLote(const ListaDeCarga* carga, void* contexto) {
+    int* numSecuencia = static_cast<int*>(contexto);
+    (*numSecuencia)++;
     
-    if (serial_port < 0) {
-        return -1;
+    std::cout << "=== SECUENCIA #" << *numSecuencia << " ===" << std::endl;
+    std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+    carga->imprimirMensaje();
+    std::cout << "---" << std::endl;
+}
+
+/**
+ * @brief Decodifica una captura completa con el motor por lotes
+ * 
+ * Parsea todo el archivo a un BufferDeTramas y lo ejecuta de una vez.
+ * 
+ * @param ruta Ruta del archivo de captura
+ * @param detector Detector de palabras clave (nullptr si no hay alertas)
+ * @param ventana Ventana de memoria fija (nullptr = lista completa)
+ * @param empaquetado Mensaje de 5 bits por símbolo (nullptr = lista de nodos)
+ * @param numRotores Rotores de la cascada (1 = protocolo original)
+ * @return Código de salida del programa
+ */
+int decodificarLote(const char* ruta, DetectorDePalabras* detector, VentanaDeCarga* ventana,
+                    MensajeEmpaquetado* empaquetado, int numRotores) {
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "✗ ERROR: No se pudo abrir el archivo " << ruta << std::endl;
+        return 1;
     }
     
-    struct termios tty;
-    if (tcgetattr(serial_port, &tty) != 0) {
-        close(serial_port);
-        return -1;
+    BufferDeTramas* tramas = new BufferDeTramas(1024, numRotores);
+    
+    const int BLOQUE = 65536;
+    char* bloque = new char[BLOQUE];
+    ssize_t leidos;
+    while ((leidos = read(fd, bloque, BLOQUE)) > 0) {
+        tramas->parsearBloque(bloque, static_cast<size_t>(leidos));
     }
+    tramas->finalizar();
+    delete[] bloque;
+    close(fd);
     
-    // Configurar baudrate 115200
-    cfsetispeed(&tty, B115200);
-    cfsetospeed(&tty, B115200);
+    ListaDeCarga* carga = new ListaDeCarga();
+    carga->setDetector(detector);
+    carga->setVentana(ventana);
+    carga->setEmpaquetado(empaquetado);
+    int numSecuencia = 0;
     
-    // 8N1
-    tty.c_cflag &= ~PARENB;        // Sin paridad
-    tty.c_cflag &= ~CSTOPB;        // 1 bit de parada
-    tty.c_cflag &= ~CSIZE;
-    tty.c_cflag |= CS8;            // 8 bits
+    RotorDeMapeo* rotor = nullptr;
+    CascadaDeRotores* cascada = nullptr;
+    if (numRotores > 1) {
+        cascada = new CascadaDeRotores(numRotores);
+        tramas->ejecutar(carga, cascada, imprimirSecuenciaLote, &numSecuencia);
+    } else {
+        rotor = new RotorDeMapeo();
+        tramas->ejecutar(carga, rotor, imprimirSecuenciaLote, &numSecuencia);
+    }
     
-    tty.c_cflag &= ~CRTSCTS;       // Sin control de flujo hardware
-    tty.c_cflag |= CREAD | CLOCAL; // Activar lectura
+    // Última secuencia (sin marcador de reinicio al final)
+    if (!carga->estaVacia()) {
+        imprimirSecuenciaLote(carga, &numSecuencia);
+    }
     
-    tty.c_lflag &= ~ICANON;        // Modo no canónico
-    tty.c_lflag &= ~ECHO;
-    tty.c_lflag &= ~ECHOE;
-    tty.c_lflag &= ~ECHONL;
-    tty.c_lflag &= ~ISIG;
+    if (tramas->obtenerErrores() > 0) {
+        std::cerr << "[AVISO] " << tramas->obtenerErrores() << " tramas mal formadas descartadas" << std::endl;
+    }
     
-    tty.c_iflag &= ~(IXON | IXOFF | IXANY); // Sin control de flujo software
-    tty.c_iflag &= ~(IGNBRK|BRKINT|PARMRK|ISTRIP|INLCR|IGNCR|ICRNL);
+    delete tramas;
+    delete rotor;
+    delete cascada;
+    delete carga;
     
-    tty.c_oflag &= ~OPOST;
-    tty.c_oflag &= ~ONLCR;
+    return 0;
+}
+
+/**
+ * @brief Codifica un archivo de texto plano a tramas PRT-7 en stdout
+ * 
+ * Cada línea del archivo se convierte en una secuencia terminada por
+ * el marcador de reinicio; sirve para generar tráfico de prueba.
+ * 
+ * @param ruta Ruta del archivo de texto
+ * @param objetivo Criterio del planificador
+ * @param mapCadaN Forzar una trama MAP cada N tramas LOAD (0 = sin forzar)
+ * @return Código de salida del programa
+ */
+int codificarArchivo(const char* ruta, CodificadorPRT7::Objetivo objetivo, int mapCadaN) {
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "✗ ERROR: No se pudo abrir el archivo " << ruta << std::endl;
+        return 1;
+    }
     
-    tty.c_cc[VTIME] = 10;  // Timeout de 1 segundo
-    tty.c_cc[VMIN] = 0;
+    CodificadorPRT7* codificador = new CodificadorPRT7(objetivo, mapCadaN);
     
-    if (tcsetattr(serial_port, TCSANOW, &tty) != 0) {
-        close(serial_port);
-        return -1;
+    const int BLOQUE = 65536;
+    char* bloque = new char[BLOQUE];
+    ssize_t leidos;
+    while ((leidos = read(fd, bloque, BLOQUE)) > 0) {
+        codificador->codificar(bloque, static_cast<size_t>(leidos));
+        std::cout.write(codificador->obtenerSalida(),
+                        static_cast<std::streamsize>(codificador->obtenerLongitud()));
+        codificador->limpiarSalida();
     }
+    std::cout.flush();
+    
+    std::cerr << "[CODIFICADOR] " << codificador->obtenerTramasLoad() << " tramas LOAD, "
+              << codificador->obtenerTramasMap() << " tramas MAP" << std::endl;
     
-    return serial_port;
+    delete[] bloque;
+    delete codificador;
+    close(fd);
+    
+    return 0;
 }
 
 /**
- * @brief Procesa una línea de entrada (parseo C-style)
- * @param linea Buffer con la línea leída (será modificado por strtok)
- * @param rotor Puntero al rotor de mapeo
- * @param carga Puntero a la lista de carga
+ * @brief Informa el resultado de verificar la secuencia parcial (modo resincronización)
+ * @param resincronizador Resincronizador ya verificado
  */
-void procesarLinea(char* linea, RotorDeMapeo* rotor, ListaDeCarga* carga) {
-    // Eliminar saltos de línea
-    char* pos = linea;
-    while (*pos) {
-        if (*pos == '\n' || *pos == '\r') {
-            *pos = '\0';
+void informarResincronizacion(const ResincronizadorPRT7* resincronizador) {
+    switch (resincronizador->obtenerVeredicto()) {
+        case ResincronizadorPRT7::CONFIRMADO:
+            std::cout << "[RESINCRONIZACIÓN] Secuencia parcial CONFIRMADA (desplazamiento inicial "
+                      << resincronizador->obtenerDesplazamientoInicial() << ")" << std::endl;
+            break;
+        case ResincronizadorPRT7::CORREGIDO:
+            std::cout << "[RESINCRONIZACIÓN] Secuencia parcial RECALCULADA (desplazamiento inicial "
+                      << resincronizador->obtenerDesplazamientoInicial() << "):" << std::endl;
+            std::cout.write(resincronizador->obtenerCorregido(),
+                            static_cast<std::streamsize>(resincronizador->obtenerLongCorregido()));
+            std::cout << std::endl;
             break;
+        case ResincronizadorPRT7::NO_VERIFICABLE:
+            std::cout << "[RESINCRONIZACIÓN] La secuencia parcial no coincide con el guion; "
+                      << "se conserva como provisional" << std::endl;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Contexto de impresión del modo por lotes en paralelo
+ */
+struct ContextoLoteParalelo {
+    int numSecuencia;                ///< Secuencias impresas
+    DetectorDePalabras* detector;    ///< Detector de palabras (nullptr si no hay alertas)
+};
+
+/**
+ * @brief Imprime una secuencia entregada (en orden) por el DecodificadorParalelo
+ * 
+ * El detector se alimenta aquí, en el hilo principal y en orden, porque
+ * su estado es uno solo para todas las secuencias.
+ */
+void imprimirSecuenciaParalela(const char* mensaje, size_t longitud, void* contexto) {
+    ContextoLoteParalelo* ctx = static_cast<ContextoLoteParalelo*>(contexto);
+    ctx->numSecuencia++;
+    
+    if (ctx->detector != nullptr) {
+        for (size_t i = 0; i < longitud; i++) {
+            ctx->detector->avanzar(mensaje[i]);
         }
-        pos++;
+        ctx->detector->reiniciarSecuencia();
     }
     
-    // Si la línea está vacía, ignorar
-    if (linea[0] == '\0') return;
+    std::cout << "=== SECUENCIA #" << ctx->numSecuencia << " ===" << std::endl;
+    std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+    std::cout.write(mensaje, static_cast<std::streamsize>(longitud));
+    std::cout << std::endl;
+    std::cout << "---" << std::endl;
+}
+
+/**
+ * @brief Decodifica una captura con las secuencias repartidas entre varios hilos
+ * @param ruta Ruta del archivo de captura
+ * @param detector Detector de palabras clave (nullptr si no hay alertas)
+ * @param numHilos Hilos trabajadores (0 = uno por núcleo)
+ * @param numRotores Rotores de la cascada (1 = protocolo original)
+ * @return Código de salida del programa
+ */
+int decodificarLoteParalelo(const char* ruta, DetectorDePalabras* detector, int numHilos, int numRotores) {
+    DecodificadorParalelo* paralelo = new DecodificadorParalelo(numHilos, numRotores);
     
-    // Parsear: formato "L,X" o "M,N"
-    char tipo = linea[0];
+    ContextoLoteParalelo ctx;
+    ctx.numSecuencia = 0;
+    ctx.detector = detector;
     
-    if (tipo == 'L' || tipo == 'l') {
-        // Trama LOAD
-        if (linea[1] != ',') {
-            std::cerr << "[ERROR] Formato inválido. Esperado: L,<caracter>" << std::endl;
-            return;
-        }
-        
-        // Extraer el dato después de la coma
-        char* dato = linea + 2;  // Saltar "L,"
-        
-        char caracter;
-        
-        // Detectar "Space" y convertirlo a espacio
-        if (strcmp_nocase(dato, "space") || strcmp_nocase(dato, "Space")) {
-            caracter = ' ';
-        } else if (dato[0] != '\0') {
-            caracter = dato[0];  // Tomar primer carácter
-        } else {
-            std::cerr << "[ERROR] Trama LOAD sin dato" << std::endl;
-            return;
-        }
-        
-        // Crear y procesar trama
-        TramaLoad* trama = new TramaLoad(caracter);
-        trama->procesar(carga, rotor);
-        delete trama;
-        
-    } else if (tipo == 'M' || tipo == 'm') {
-        // Trama MAP
-        if (linea[1] != ',') {
-            std::cerr << "[ERROR] Formato inválido. Esperado: M,<numero>" << std::endl;
-            return;
-        }
-        
-        // Extraer el número después de la coma
-        char* dato = linea + 2;  // Saltar "M,"
-        int rotacion = atoi(dato);  // Convierte a int (soporta negativos)
-        
-        // Crear y procesar trama
-        TramaMap* trama = new TramaMap(rotacion);
-        trama->procesar(carga, rotor);
-        delete trama;
-        
-    } else {
-        // Ignorar líneas que no son tramas (como separadores ---, líneas vacías, etc.)
-        bool esSeparador = true;
-        for (int i = 0; linea[i] != '\0'; i++) {
-            if (linea[i] != '-' && linea[i] != ' ' && linea[i] != '\t') {
-                esSeparador = false;
-                break;
-            }
-        }
+    int errores = paralelo->decodificarArchivo(ruta, imprimirSecuenciaParalela, &ctx);
+    if (errores < 0) {
+        std::cerr << "✗ ERROR: No se pudo abrir el archivo " << ruta << std::endl;
+        delete paralelo;
+        return 1;
+    }
+    
+    if (errores > 0) {
+        std::cerr << "[AVISO] " << errores << " tramas mal formadas descartadas" << std::endl;
+    }
+    std::cerr << "[PARALELO] " << paralelo->obtenerNumSecuencias() << " secuencias en "
+              << paralelo->obtenerNumHilos() << " hilos, " << paralelo->obtenerRobos()
+              << " robos de trabajo" << std::endl;
+    
+    delete paralelo;
+    return 0;
+}
 
-        if (!esSeparador && linea[0] != '\0') {
+/**
+ * @brief Contexto de impresión del modo interactivo
+ */
+struct ContextoSerial {
+    SesionPRT7* sesion;                      ///< Sesión que entrega los eventos
+    const ResincronizadorPRT7* resincronizador;  ///< Para informar el veredicto (nullptr si no hay)
+    bool terminar;                           ///< El usuario pidió salir
+};
+
+/**
+ * @brief Imprime un evento de la sesión en el formato del receptor original
+ * 
+ * Al terminar cada secuencia pregunta si se continúa; si la respuesta
+ * es no, detiene la sesión.
+ */
+void imprimirEventoSerial(const EventoPRT7* evento, void* contexto) {
+    ContextoSerial* ctx = static_cast<ContextoSerial*>(contexto);
+    
+    switch (evento->tipo) {
+        case EventoPRT7::CARGA:
+            std::cout << "Trama recibida: [" << evento->linea << "] -> Procesando... -> Fragmento '"
+                      << evento->codificado << "' decodificado como '" << evento->decodificado << "'. ";
+            ctx->sesion->obtenerCarga()->imprimirMensajeParcial();
+            break;
+            
+        case EventoPRT7::MAPEO:
+            std::cout << std::endl;
+            std::cout << "Trama recibida: [" << evento->linea << "] -> Procesando... -> ROTANDO ROTOR ";
+            if (ctx->sesion->obtenerNumRotores() > 1) std::cout << evento->indiceRotor << " ";
+            if (evento->rotacion >= 0) std::cout << "+";
+            std::cout << evento->rotacion << ". (Ahora 'A' se mapea a '" << evento->mapeoA << "')" << std::endl;
+            std::cout << std::endl;
+            break;
+            
+        case EventoPRT7::ERROR_TRAMA:
+            if (evento->codigoError == EventoPRT7::LOAD_SIN_DATO) {
+                std::cerr << "[ERROR] Trama LOAD sin dato" << std::endl;
+            } else if (evento->codigoError == EventoPRT7::FORMATO_MAP) {
+                std::cerr << "[ERROR] Formato inválido. Esperado: M,<numero> o M<rotor>,<numero>" << std::endl;
+            } else {
+                std::cerr << "[ERROR] Rotor " << evento->indiceRotor << " inexistente (hay "
+                          << ctx->sesion->obtenerNumRotores() << " rotores: 0 a "
+                          << ctx->sesion->obtenerNumRotores() - 1 << ")" << std::endl;
+            }
+            break;
+            
+        case EventoPRT7::FIN_SECUENCIA: {
+            std::cout << std::endl;
+            std::cout << "---" << std::endl;
+            std::cout << "Flujo de datos terminado." << std::endl;
+            if (evento->provisional) {
+                std::cout << "MENSAJE OCULTO ENSAMBLADO (PROVISIONAL):" << std::endl;
+            } else {
+                std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+            }
+            ctx->sesion->obtenerCarga()->imprimirMensaje();
+            std::cout << "---" << std::endl;
+            std::cout << std::endl;
+            
+            // Resultado de confirmar o recalcular la secuencia parcial
+            if (evento->veredicto != ResincronizadorPRT7::PENDIENTE) {
+                informarResincronizacion(ctx->resincronizador);
+                std::cout << std::endl;
+            }
+            
+            // Preguntar si desea continuar
+            std::cout << "¿Desea continuar con la siguiente secuencia? (Y/N): ";
+            std::cout.flush();
+            
+            // Sin respuesta (fin de la entrada o error de lectura) se termina
+            char respuesta = 'N';
+            if (std::cin >> respuesta) {
+                std::cin.ignore(); // Limpiar el buffer
+            }
+            
+            if (respuesta != 'Y' && respuesta != 'y') {
+                std::cout << "Finalizando programa..." << std::endl;
+                ctx->terminar = true;
+                ctx->sesion->detener();
+                return;
+            }
+            std::cout << std::endl;
+            break;
         }
+            
+        case EventoPRT7::INICIO_SECUENCIA:
+            // Solo mostrar desde la secuencia 2 en adelante (la 1 es la descartada)
+            if (evento->numSecuencia > 1 && !ctx->terminar) {
+                std::cout << "=== SECUENCIA #" << (evento->numSecuencia - 1) << " ===" << std::endl;
+                std::cout << std::endl;
+            }
+            break;
     }
 }
 
 /**
- * @brief Función principal - Lee del stdin (simulando puerto serial)
+ * @brief Modo interactivo: lee tramas del puerto serial
+ * 
+ * Los bytes leídos se entregan a una SesionPRT7; este modo solo imprime
+ * sus eventos. Sin resincronización descarta la primera secuencia
+ * (puede estar incompleta). Con resincronización la decodifica de
+ * inmediato como provisional y la confirma o recalcula al cerrar la
+ * siguiente.
+ * 
+ * @param serie Puerto, velocidad y perfil de lectura
+ * @param detector Detector de palabras clave (nullptr si no hay alertas)
+ * @param resincronizar Decodificar desde la primera trama recibida
+ * @param ventana Ventana de memoria fija (nullptr = lista completa)
+ * @param empaquetado Mensaje de 5 bits por símbolo (nullptr = lista de nodos)
+ * @param numRotores Rotores de la cascada (1 = protocolo original)
+ * @return Código de salida del programa
  */
-int main() {
+int decodificarSerial(const ConfiguracionSerial& serie, DetectorDePalabras* detector,
+                      bool resincronizar, VentanaDeCarga* ventana, MensajeEmpaquetado* empaquetado,
+                      int numRotores) {
     std::cout << "=== DECODIFICADOR PRT-7 ===" << std::endl;
     std::cout << "Iniciando Decodificador PRT-7. Conectando a puerto COM..." << std::endl;
     
     // Intentar conectar al ESP32
-    const char* puertoSerial = "/dev/ttyUSB0";
-    int serial_fd = configurarPuertoSerial(puertoSerial);
+    const char* puertoSerial = serie.ruta;
+    bool bajaLatencia = false;
+    int serial_fd = configurarPuertoSerial(puertoSerial, serie.baudios, serie.perfil, &bajaLatencia);
     
     if (serial_fd < 0) {
         std::cerr << "✗ ERROR: No se pudo abrir el puerto " << puertoSerial << std::endl;
@@ -195,6 +417,10 @@ int main() {
     }
     
     std::cout << "Conexión establecida. Esperando tramas..." << std::endl;
+    if (serie.perfil == PERFIL_BAJA_LATENCIA && !bajaLatencia) {
+        std::cerr << "[AVISO] El driver de " << puertoSerial
+                  << " no soporta ASYNC_LOW_LATENCY (solo se ajustan VMIN/VTIME)" << std::endl;
+    }
     std::cout << "NOTA: Si el ESP32 ya estaba transmitiendo, presiona el botón RESET para reiniciar la secuencia." << std::endl;
     std::cout << std::endl;
     
@@ -202,92 +428,42 @@ int main() {
     tcflush(serial_fd, TCIFLUSH);
     usleep(100000); // Esperar 100ms
     
-    // Crear estructuras de datos usando punteros
-    RotorDeMapeo* rotor = new RotorDeMapeo();
-    ListaDeCarga* carga = new ListaDeCarga();
+    ContextoSerial ctx;
+    ctx.resincronizador = nullptr;
+    ctx.terminar = false;
     
-    const int BUFFER_SIZE = 256;
-    char buffer[BUFFER_SIZE];
-    int bufferPos = 0;
-    int tramasRecibidas = 0;
-    int secuenciaNum = 0; // Empezar en 0 para ignorar la primera secuencia
+    SesionPRT7* sesion = new SesionPRT7(numRotores, imprimirEventoSerial, &ctx);
+    ctx.sesion = sesion;
+    sesion->setDetector(detector);
+    sesion->setVentana(ventana);
+    sesion->setEmpaquetado(empaquetado);
     
-    std::cout << "Esperando primera secuencia completa (descartando datos parciales)..." << std::endl;
+    // Con resincronización la primera secuencia se decodifica como provisional
+    ResincronizadorPRT7* resincronizador = nullptr;
+    if (resincronizar) {
+        resincronizador = new ResincronizadorPRT7();
+        ctx.resincronizador = resincronizador;
+        sesion->setResincronizador(resincronizador);
+        std::cout << "Resincronización activa: decodificando de inmediato (salida PROVISIONAL hasta confirmar)..." << std::endl;
+    } else {
+        sesion->setEsperarReinicio(true);
+        std::cout << "Esperando primera secuencia completa (descartando datos parciales)..." << std::endl;
+    }
     std::cout << "Presiona Ctrl+C para detener el programa." << std::endl;
     std::cout << std::endl;
     
     // Leer del puerto serial continuamente
-    while (true) {
-        char c;
-        int n = read(serial_fd, &c, 1);
+    const int BUFFER_SIZE = tamLecturaPerfil(serie.perfil);
+    char* buffer = new char[BUFFER_SIZE];
+    while (!ctx.terminar) {
+        ssize_t n;
+        {
+            PRT7_TRAZA("main:read");
+            n = read(serial_fd, buffer, BUFFER_SIZE);
+        }
         
         if (n > 0) {
-            if (c == '\n' || c == '\r') {
-                if (bufferPos > 0) {
-                    buffer[bufferPos] = '\0';
-                    
-                    // Detectar reinicio de secuencia
-                    if (strstr(buffer, "REINICIANDO SECUENCIA") != nullptr) {
-                        // Mostrar mensaje final de la secuencia anterior (solo si no es la primera)
-                        if (tramasRecibidas > 0 && secuenciaNum > 0) {
-                            std::cout << std::endl;
-                            std::cout << "---" << std::endl;
-                            std::cout << "Flujo de datos terminado." << std::endl;
-                            std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
-                            carga->imprimirMensaje();
-                            std::cout << "---" << std::endl;
-                            std::cout << std::endl;
-                            
-                            // Preguntar si desea continuar
-                            std::cout << "¿Desea continuar con la siguiente secuencia? (Y/N): ";
-                            std::cout.flush();
-                            
-                            char respuesta;
-                            std::cin >> respuesta;
-                            std::cin.ignore(); // Limpiar el buffer
-                            
-                            if (respuesta != 'Y' && respuesta != 'y') {
-                                std::cout << "Finalizando programa..." << std::endl;
-                                std::cout << "Liberando memoria... Sistema apagado." << std::endl;
-                                close(serial_fd);
-                                delete rotor;
-                                delete carga;
-                                return 0;
-                            }
-                            std::cout << std::endl;
-                        }
-                        
-                        // Incrementar secuencia
-                        secuenciaNum++;
-                        tramasRecibidas = 0;
-                        
-                        // Limpiar las estructuras (borrar y crear nuevas)
-                        delete rotor;
-                        delete carga;
-                        rotor = new RotorDeMapeo();
-                        carga = new ListaDeCarga();
-                        
-                        // Solo mostrar desde la secuencia 2 en adelante (secuenciaNum > 1)
-                        if (secuenciaNum > 1) {
-                            std::cout << "=== SECUENCIA #" << (secuenciaNum - 1) << " ===" << std::endl;
-                            std::cout << std::endl;
-                        }
-                    } else if ((buffer[0] == 'L' || buffer[0] == 'l' || 
-                                buffer[0] == 'M' || buffer[0] == 'm') && 
-                               buffer[1] == ',') {
-                        // Solo procesar y mostrar si no es la primera secuencia
-                        if (secuenciaNum > 0) {
-                            procesarLinea(buffer, rotor, carga);
-                            tramasRecibidas++;
-                        }
-                    }
-                    // Ignorar cualquier otra línea (---, líneas vacías, etc.)
-                    
-                    bufferPos = 0;
-                }
-            } else if (bufferPos < BUFFER_SIZE - 1) {
-                buffer[bufferPos++] = c;
-            }
+            sesion->alimentar(buffer, static_cast<size_t>(n));
         } else if (n < 0) {
             std::cerr << "Error al leer del puerto serial" << std::endl;
             break;
@@ -298,21 +474,335 @@ int main() {
     close(serial_fd);
     
     // Mostrar último mensaje si hay datos pendientes
-    std::cout << std::endl;
-    
-    if (tramasRecibidas > 0) {
-        std::cout << "---" << std::endl;
-        std::cout << "Flujo de datos terminado." << std::endl;
-        std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
-        carga->imprimirMensaje();
-        std::cout << "---" << std::endl;
+    if (!ctx.terminar) {
+        std::cout << std::endl;
+        
+        if (sesion->obtenerTramasSecuencia() > 0) {
+            std::cout << "---" << std::endl;
+            std::cout << "Flujo de datos terminado." << std::endl;
+            std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+            sesion->obtenerCarga()->imprimirMensaje();
+            std::cout << "---" << std::endl;
+        }
     }
     
     // Liberar memoria
-    delete rotor;
-    delete carga;
+    delete[] buffer;
+    delete sesion;
+    delete resincronizador;
+    
+    std::cout << "Liberando memoria... Sistema apagado." << std::endl;
+    
+    return 0;
+}
+
+/**
+ * @brief Servidor activo (para detenerlo desde el manejador de señales)
+ */
+static ServidorPRT7* servidorActivo = nullptr;
+
+/**
+ * @brief Manejador de SIGINT/SIGTERM en modo servidor
+ */
+void detenerServidor(int) {
+    if (servidorActivo != nullptr) {
+        servidorActivo->detener();
+    }
+}
+
+/**
+ * @brief Modo servidor: recibe tramas de muchos productores por socket local
+ * @param rutaUnix Ruta del socket UNIX (nullptr para usar TCP)
+ * @param puertoTcp Puerto TCP en 127.0.0.1 (si rutaUnix es nullptr)
+ * @param numRotores Rotores de cada conexión (1 = protocolo original)
+ * @return Código de salida del programa
+ */
+int decodificarServidor(const char* rutaUnix, int puertoTcp, int numRotores) {
+    ServidorPRT7* servidor = new ServidorPRT7(numRotores);
     
+    if (rutaUnix != nullptr) {
+        if (!servidor->escucharUnix(rutaUnix)) {
+            std::cerr << "✗ ERROR: No se pudo escuchar en " << rutaUnix << std::endl;
+            delete servidor;
+            return 1;
+        }
+        std::cout << "Servidor PRT-7 escuchando en " << rutaUnix << std::endl;
+    } else {
+        int puerto = servidor->escucharTcp(puertoTcp);
+        if (puerto < 0) {
+            std::cerr << "✗ ERROR: No se pudo escuchar en 127.0.0.1:" << puertoTcp << std::endl;
+            delete servidor;
+            return 1;
+        }
+        std::cout << "Servidor PRT-7 escuchando en 127.0.0.1:" << puerto << std::endl;
+    }
+    std::cout << "Presiona Ctrl+C para detener el servidor." << std::endl;
+    
+    servidorActivo = servidor;
+    signal(SIGINT, detenerServidor);
+    signal(SIGTERM, detenerServidor);
+    
+    servidor->ejecutar();
+    
+    servidorActivo = nullptr;
+    std::cout << std::endl;
+    std::cout << "Conexiones atendidas: " << servidor->obtenerConexionesTotales() << std::endl;
+    if (servidor->obtenerConexionesRechazadas() > 0) {
+        std::cout << "Conexiones rechazadas (sin descriptores): "
+                  << servidor->obtenerConexionesRechazadas() << std::endl;
+    }
+    std::cout << "Tramas decodificadas: " << servidor->obtenerTramasProcesadas() << std::endl;
+    std::cout << "Mensajes enviados: " << servidor->obtenerMensajesEnviados() << std::endl;
     std::cout << "Liberando memoria... Sistema apagado." << std::endl;
     
+    delete servidor;
     return 0;
 }
+
+/**
+ * @brief Muestra las opciones de línea de comandos
+ */
+void mostrarUso() {
+    std::cerr << "Uso: DecodificadorPRT7 [opciones]" << std::endl;
+    std::cerr << "  --lote <archivo>   Decodifica una captura con el motor por lotes" << std::endl;
+    std::cerr << "  --log <archivo>    Copia la salida a un archivo (asíncrono)" << std::endl;
+    std::cerr << "  --socket <ruta>    Copia la salida a un socket UNIX (asíncrono)" << std::endl;
+    std::cerr << "  --servidor-unix <ruta>     Recibe tramas por un socket UNIX" << std::endl;
+    std::cerr << "  --servidor-tcp <puerto>    Recibe tramas por TCP en 127.0.0.1" << std::endl;
+    std::cerr << "  --alerta <palabra>         Avisa al decodificar la palabra (repetible)" << std::endl;
+    std::cerr << "  --resincronizar            Decodifica desde la primera trama (salida provisional)" << std::endl;
+    std::cerr << "  --hilos <n>                Con --lote: decodifica las secuencias en paralelo (0 = un hilo por núcleo)" << std::endl;
+    std::cerr << "  --ventana <n>              Guarda en memoria solo los últimos n caracteres (mínimo 4096, en bloques de 4096)" << std::endl;
+    std::cerr << "  --segmento <archivo>       Agrega al archivo lo que sale de la ventana" << std::endl;
+    std::cerr << "  --empaquetar               Guarda el mensaje a 5 bits por símbolo en lugar de nodos" << std::endl;
+    std::cerr << "  --rotores <n>              Cascada de n rotores (tramas M<k>,N con k de 0 a n-1; por defecto: 1)" << std::endl;
+    std::cerr << "  --codificar <archivo>      Codifica texto plano a tramas en stdout" << std::endl;
+    std::cerr << "  --objetivo tramas|bytes    Criterio del codificador (por defecto: tramas; bytes es más lento)" << std::endl;
+    std::cerr << "  --map-cada <n>             Forzar una trama MAP cada n tramas LOAD (0 = sin forzar)" << std::endl;
+    std::cerr << "  --puerto <ruta>            Puerto serial (por defecto: /dev/ttyUSB0)" << std::endl;
+    std::cerr << "  --baudios <n>              Velocidad del puerto, hasta 4000000 (por defecto: 115200)" << std::endl;
+    std::cerr << "  --perfil clasico|latencia|volumen   Perfil de lectura del puerto (por defecto: clasico)" << std::endl;
+}
+
+/**
+ * @brief Función principal
+ * 
+ * Sin opciones lee del puerto serial; --lote, --servidor-* y
+ * --codificar eligen los otros modos. Con --log o --socket la salida
+ * de consola pasa por un EscritorAsincrono que la copia a todos los
+ * destinos desde un hilo dedicado.
+ */
+int main(int argc, char* argv[]) {
+    const char* rutaLote = nullptr;
+    const char* rutaLog = nullptr;
+    const char* rutaSocket = nullptr;
+    const char* rutaServidor = nullptr;
+    int puertoServidor = -1;
+    const char* rutaCodificar = nullptr;
+    CodificadorPRT7::Objetivo objetivo = CodificadorPRT7::MINIMO_TRAMAS;
+    int mapCadaN = 0;
+    bool resincronizar = false;
+    long capacidadVentana = 0;
+    int numHilos = -1;
+    const char* rutaSegmento = nullptr;
+    bool empaquetar = false;
+    int numRotores = 1;
+    
+    ConfiguracionSerial serie;
+    serie.ruta = "/dev/ttyUSB0";
+    serie.baudios = 115200;
+    serie.perfil = PERFIL_CLASICO;
+    
+    const int MAX_ALERTAS = 32;
+    const char* alertas[MAX_ALERTAS];
+    int numAlertas = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            rutaLote = argv[++i];
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            rutaLog = argv[++i];
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            rutaSocket = argv[++i];
+        } else if (strcmp(argv[i], "--servidor-unix") == 0 && i + 1 < argc) {
+            rutaServidor = argv[++i];
+        } else if (strcmp(argv[i], "--servidor-tcp") == 0 && i + 1 < argc) {
+            puertoServidor = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--alerta") == 0 && i + 1 < argc && numAlertas < MAX_ALERTAS) {
+            alertas[numAlertas++] = argv[++i];
+        } else if (strcmp(argv[i], "--hilos") == 0 && i + 1 < argc) {
+            numHilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            capacidadVentana = atol(argv[++i]);
+            if (capacidadVentana < static_cast<long>(VentanaDeCarga::TAM_BLOQUE)) {
+                std::cerr << "[ERROR] La ventana debe tener al menos " << VentanaDeCarga::TAM_BLOQUE
+                          << " caracteres: " << argv[i] << std::endl;
+                mostrarUso();
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--segmento") == 0 && i + 1 < argc) {
+            rutaSegmento = argv[++i];
+        } else if (strcmp(argv[i], "--empaquetar") == 0) {
+            empaquetar = true;
+        } else if (strcmp(argv[i], "--rotores") == 0 && i + 1 < argc) {
+            numRotores = atoi(argv[++i]);
+            if (numRotores < 1) {
+                std::cerr << "[ERROR] Número de rotores inválido: " << argv[i] << std::endl;
+                mostrarUso();
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--resincronizar") == 0) {
+            resincronizar = true;
+        } else if (strcmp(argv[i], "--codificar") == 0 && i + 1 < argc) {
+            rutaCodificar = argv[++i];
+        } else if (strcmp(argv[i], "--objetivo") == 0 && i + 1 < argc) {
+            const char* nombre = argv[++i];
+            if (strcmp_nocase(nombre, "tramas")) {
+                objetivo = CodificadorPRT7::MINIMO_TRAMAS;
+            } else if (strcmp_nocase(nombre, "bytes")) {
+                objetivo = CodificadorPRT7::MINIMO_BYTES;
+            } else {
+                std::cerr << "[ERROR] Objetivo inválido: " << nombre << std::endl;
+                mostrarUso();
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--map-cada") == 0 && i + 1 < argc) {
+            char* fin = nullptr;
+            long n = strtol(argv[++i], &fin, 10);
+            if (fin == argv[i] || *fin != '\0' || n < 0 || n > INT_MAX) {
+                std::cerr << "[ERROR] Valor inválido para --map-cada: " << argv[i] << std::endl;
+                mostrarUso();
+                return 1;
+            }
+            mapCadaN = static_cast<int>(n);
+        } else if (strcmp(argv[i], "--puerto") == 0 && i + 1 < argc) {
+            serie.ruta = argv[++i];
+        } else if (strcmp(argv[i], "--baudios") == 0 && i + 1 < argc) {
+            serie.baudios = atoi(argv[++i]);
+            speed_t velocidad;
+            if (!velocidadTermios(serie.baudios, &velocidad)) {
+                std::cerr << "[ERROR] Velocidad no soportada: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--perfil") == 0 && i + 1 < argc) {
+            const char* nombre = argv[++i];
+            if (strcmp_nocase(nombre, "latencia")) {
+                serie.perfil = PERFIL_BAJA_LATENCIA;
+            } else if (strcmp_nocase(nombre, "volumen")) {
+                serie.perfil = PERFIL_VOLUMEN;
+            } else if (strcmp_nocase(nombre, "clasico")) {
+                serie.perfil = PERFIL_CLASICO;
+            } else {
+                std::cerr << "[ERROR] Perfil inválido: " << nombre << std::endl;
+                mostrarUso();
+                return 1;
+            }
+        } else {
+            std::cerr << "[ERROR] Opción inválida: " << argv[i] << std::endl;
+            mostrarUso();
+            return 1;
+        }
+    }
+    
+    // La resincronización alinea el guion con la suma de rotaciones de un solo rotor
+    if (resincronizar && numRotores > 1) {
+        std::cerr << "[ERROR] --resincronizar solo funciona con un rotor" << std::endl;
+        return 1;
+    }
+    
+    // Salida asíncrona multi-destino (solo si se pidió algún destino extra)
+    EscritorAsincrono* escritor = nullptr;
+    FlujoAsincrono* flujo = nullptr;
+    std::streambuf* bufferOriginal = nullptr;
+    
+    if (rutaLog != nullptr || rutaSocket != nullptr) {
+        const size_t LIMITE_CONSOLA = 1 << 20;   // 1 MB
+        const size_t LIMITE_EXTERNO = 8 << 20;   // 8 MB
+        
+        escritor = new EscritorAsincrono();
+        
+        // La consola no pierde datos; los destinos externos descartan si se atrasan
+        escritor->agregarDescriptor(STDOUT_FILENO, EscritorAsincrono::BLOQUEAR, LIMITE_CONSOLA);
+        
+        if (rutaLog != nullptr &&
+            escritor->agregarArchivo(rutaLog, EscritorAsincrono::DESCARTAR, LIMITE_EXTERNO) < 0) {
+            std::cerr << "✗ ERROR: No se pudo abrir el archivo de log " << rutaLog << std::endl;
+        }
+        if (rutaSocket != nullptr &&
+            escritor->agregarSocketUnix(rutaSocket, EscritorAsincrono::DESCARTAR, LIMITE_EXTERNO) < 0) {
+            std::cerr << "✗ ERROR: No se pudo conectar al socket " << rutaSocket << std::endl;
+        }
+        
+        escritor->iniciar();
+        flujo = new FlujoAsincrono(escritor);
+        bufferOriginal = std::cout.rdbuf(flujo);
+    }
+    
+    // Detector de palabras clave (Aho-Corasick) sobre la salida decodificada
+    DetectorDePalabras* detector = nullptr;
+    if (numAlertas > 0) {
+        detector = new DetectorDePalabras(avisarPalabraDetectada, alertas);
+        for (int i = 0; i < numAlertas; i++) {
+            if (!detector->agregarPatron(alertas[i], i)) {
+                std::cerr << "[ERROR] Palabra de alerta inválida (solo A-Z y espacio): "
+                          << alertas[i] << std::endl;
+            }
+        }
+        detector->construir();
+    }
+    
+    // Ventana de memoria fija para secuencias sin marcador de reinicio
+    VentanaDeCarga* ventana = nullptr;
+    if (capacidadVentana > 0) {
+        ventana = new VentanaDeCarga(static_cast<size_t>(capacidadVentana), rutaSegmento);
+        std::cerr << "[VENTANA] " << ventana->obtenerCapacidad() << " caracteres en memoria";
+        if (ventana->obtenerCapacidad() != static_cast<size_t>(capacidadVentana)) {
+            std::cerr << " (" << capacidadVentana << " redondeado a bloques de "
+                      << VentanaDeCarga::TAM_BLOQUE << ")";
+        }
+        std::cerr << std::endl;
+        if (rutaSegmento == nullptr) {
+            std::cerr << "[AVISO] Sin --segmento: lo que salga de la ventana se descarta" << std::endl;
+        } else if (!ventana->tieneSegmento()) {
+            std::cerr << "✗ ERROR: No se pudo abrir el segmento " << rutaSegmento
+                      << " (lo que salga de la ventana se descarta)" << std::endl;
+        }
+    }
+    
+    // Mensaje empaquetado a 5 bits (la ventana tiene prioridad si hay ambas)
+    MensajeEmpaquetado* empaquetado = empaquetar ? new MensajeEmpaquetado() : nullptr;
+    
+    int codigo;
+    if (rutaCodificar != nullptr) {
+        codigo = codificarArchivo(rutaCodificar, objetivo, mapCadaN);
+    } else if (rutaServidor != nullptr || puertoServidor >= 0) {
+        codigo = decodificarServidor(rutaServidor, puertoServidor, numRotores);
+    } else if (rutaLote != nullptr && numHilos >= 0 && ventana == nullptr && empaquetado == nullptr) {
+        codigo = decodificarLoteParalelo(rutaLote, detector, numHilos, numRotores);
+    } else if (rutaLote != nullptr) {
+        codigo = decodificarLote(rutaLote, detector, ventana, empaquetado, numRotores);
+    } else {
+        codigo = decodificarSerial(serie, detector, resincronizar, ventana, empaquetado, numRotores);
+    }
+    
+    delete detector;
+    delete ventana;
+    delete empaquetado;
+    
+    if (escritor != nullptr) {
+        std::cout.flush();
+        std::cout.rdbuf(bufferOriginal);
+        delete flujo;
+        
+        escritor->detener();
+        for (int i = 1; i < escritor->obtenerNumDestinos(); i++) {
+            EstadisticasDestino e = escritor->obtenerEstadisticas(i);
+            std::cerr << "[SALIDA] Destino " << i << ": " << e.bytesEscritos << " bytes, "
+                      << e.mensajesDescartados << " mensajes descartados, "
+                      << e.llamadasWritev << " writev" << std::endl;
+        }
+        delete escritor;
+    }
+    
+    return codigo;
+}
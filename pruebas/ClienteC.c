@@ -0,0 +1,99 @@
+/**
+ * @file ClienteC.c
+ * @brief Cliente en C de libprt7.so (ctest)
+ * 
+ * Usa solo prt7.h, como lo haría un programa en C o un enlace por FFI:
+ * decodifica el ejemplo del enunciado entregando los bytes en tramos
+ * de distinto tamaño y compara los mensajes copiados con
+ * prt7_copiar_mensaje contra los esperados.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "prt7.h"
+
+/**
+ * @brief Estado del cliente: mensajes copiados al terminar cada secuencia
+ */
+typedef struct {
+    prt7_sesion* sesion;   /**< Sesión que entrega los eventos */
+    char mensaje[64];      /**< Mensaje de la última secuencia terminada */
+    int secuencias;        /**< Eventos FIN_SECUENCIA */
+    int cargas;            /**< Eventos CARGA */
+    int mapeos;            /**< Eventos MAPEO */
+} ClienteC;
+
+/**
+ * @brief Cuenta los eventos y copia el mensaje de cada secuencia terminada
+ */
+static void alEvento(const prt7_evento* evento, void* contexto) {
+    ClienteC* cliente = (ClienteC*)contexto;
+    
+    switch (evento->tipo) {
+        case PRT7_CARGA:
+            cliente->cargas++;
+            break;
+        case PRT7_MAPEO:
+            cliente->mapeos++;
+            break;
+        case PRT7_FIN_SECUENCIA:
+            cliente->secuencias++;
+            prt7_copiar_mensaje(cliente->sesion, cliente->mensaje, sizeof(cliente->mensaje));
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Decodifica dos secuencias (una con marcador y otra sin él) y las compara
+ */
+int main(void) {
+    static const char TRAMAS[] =
+        "L,H\nL,O\nL,L\nM,2\nL,A\nL,Space\nL,W\nM,-2\nL,O\nL,R\nL,L\nL,D\n"
+        "--- REINICIANDO SECUENCIA ---\n"
+        "M,1\nL,N\nL,J\n";
+    static const char PRIMERO[] = "HOLC YORLD";
+    static const char SEGUNDO[] = "OK";
+    
+    ClienteC cliente;
+    memset(&cliente, 0, sizeof(cliente));
+    cliente.sesion = prt7_crear(1, alEvento, &cliente, 0);
+    if (cliente.sesion == NULL) {
+        fprintf(stderr, "ERROR: prt7_crear devolvió NULL\n");
+        return 1;
+    }
+    
+    /* Tramos de 1, 2, 3... bytes: las líneas quedan partidas entre llamadas */
+    size_t longitud = sizeof(TRAMAS) - 1;
+    size_t posicion = 0;
+    size_t tramo = 1;
+    int correcto = 1;
+    while (posicion < longitud) {
+        size_t n = longitud - posicion;
+        if (n > tramo) n = tramo;
+        if (prt7_alimentar(cliente.sesion, TRAMAS + posicion, n) != n) correcto = 0;
+        posicion += n;
+        tramo++;
+    }
+    
+    /* La segunda secuencia no tiene marcador: se lee al terminar el flujo */
+    char ultimo[64];
+    if (prt7_finalizar(cliente.sesion) != 0) correcto = 0;
+    size_t longUltimo = prt7_copiar_mensaje(cliente.sesion, ultimo, sizeof(ultimo));
+    
+    correcto = correcto && cliente.secuencias == 1 && strcmp(cliente.mensaje, PRIMERO) == 0 &&
+               longUltimo == strlen(SEGUNDO) && strcmp(ultimo, SEGUNDO) == 0 &&
+               cliente.cargas == 12 && cliente.mapeos == 3 && prt7_errores(cliente.sesion) == 0;
+    
+    printf("libprt7 %s: \"%s\" y \"%s\" (%d cargas, %d mapeos)\n",
+           prt7_version(), cliente.mensaje, ultimo, cliente.cargas, cliente.mapeos);
+    printf("%s\n", correcto ? "OK: la interfaz en C decodificó los mensajes esperados"
+                            : "ERROR: la interfaz en C no devolvió los mensajes esperados");
+    
+    prt7_destruir(cliente.sesion);
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file ClienteCompartido.cpp
+ * @brief Cliente en C++ de libprt7.so con las cabeceras instaladas (ctest)
+ * 
+ * Solo usa las clases marcadas con PRT7_API: si alguna de las que
+ * recibe SesionPRT7 quedara oculta en la biblioteca compartida, este
+ * programa no enlazaría. Decodifica el ejemplo del enunciado con cada
+ * forma de guardar el mensaje, con alertas, con resincronización y
+ * desde un pipe atendido por PlanificadorDeSesiones.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include <iostream>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include "SesionPRT7.h"
+#include "ListaDeCarga.h"
+#include "DetectorDePalabras.h"
+#include "VentanaDeCarga.h"
+#include "MensajeEmpaquetado.h"
+#include "ResincronizadorPRT7.h"
+#include "PlanificadorDeSesiones.h"
+
+/**
+ * @brief Tramas del ejemplo del enunciado
+ */
+static const char TRAMAS[] =
+    "L,H\nL,O\nL,L\nM,2\nL,A\nL,Space\nL,W\nM,-2\nL,O\nL,R\nL,L\nL,D\n";
+
+/**
+ * @brief Marcador de reinicio del emisor
+ */
+static const char MARCADOR[] = "--- REINICIANDO SECUENCIA ---\n";
+
+/**
+ * @brief Mensaje oculto del ejemplo
+ */
+static const char ESPERADO[] = "HOLC YORLD";
+
+/**
+ * @brief Cuenta las palabras detectadas
+ */
+void contarAlerta(int idPatron, int numSecuencia, int desplazamiento, void* contexto) {
+    (void)idPatron;
+    (void)numSecuencia;
+    (void)desplazamiento;
+    (*static_cast<int*>(contexto))++;
+}
+
+/**
+ * @brief Decodifica el ejemplo con la ventana o el empaquetado dados y compara el mensaje
+ */
+bool probarAlmacenamiento(const char* nombre, VentanaDeCarga* ventana, MensajeEmpaquetado* empaquetado) {
+    int alertas = 0;
+    const char* palabras[] = { "YORLD" };
+    DetectorDePalabras* detector = new DetectorDePalabras(contarAlerta, &alertas);
+    detector->agregarPatron(palabras[0], 0);
+    detector->construir();
+    
+    SesionPRT7* sesion = new SesionPRT7(1);
+    sesion->setDetector(detector);
+    sesion->setVentana(ventana);
+    sesion->setEmpaquetado(empaquetado);
+    sesion->alimentar(TRAMAS, sizeof(TRAMAS) - 1);
+    sesion->finalizar();
+    
+    char mensaje[64];
+    std::size_t longitud = sesion->obtenerCarga()->copiarA(mensaje, sizeof(mensaje));
+    bool correcto = longitud == sizeof(ESPERADO) - 1 && strcmp(mensaje, ESPERADO) == 0 &&
+                    sesion->obtenerCarga()->obtenerTamanio() == static_cast<int>(longitud) &&
+                    alertas == 1;
+    
+    std::cout << "  " << nombre << ": \"" << mensaje << "\", " << alertas << " alerta(s)"
+              << (correcto ? "" : "  <-- ERROR") << std::endl;
+    
+    delete sesion;
+    delete detector;
+    return correcto;
+}
+
+/**
+ * @brief Conecta a mitad del ejemplo y verifica que se recalcula el sufijo
+ */
+bool probarResincronizacion() {
+    const char* parcial = strstr(TRAMAS, "L,W");
+    
+    ResincronizadorPRT7* resincronizador = new ResincronizadorPRT7();
+    SesionPRT7* sesion = new SesionPRT7(1);
+    sesion->setResincronizador(resincronizador);
+    sesion->alimentar(parcial, strlen(parcial));
+    sesion->alimentar(MARCADOR, sizeof(MARCADOR) - 1);
+    sesion->alimentar(TRAMAS, sizeof(TRAMAS) - 1);
+    sesion->alimentar(MARCADOR, sizeof(MARCADOR) - 1);
+    
+    const char* sufijo = strstr(ESPERADO, "YORLD");
+    bool correcto = resincronizador->obtenerVeredicto() == ResincronizadorPRT7::CORREGIDO &&
+                    resincronizador->obtenerDesplazamientoInicial() == 2 &&
+                    resincronizador->obtenerLongCorregido() == strlen(sufijo) &&
+                    memcmp(resincronizador->obtenerCorregido(), sufijo, strlen(sufijo)) == 0;
+    
+    std::cout << "  resincronización: desplazamiento inicial "
+              << resincronizador->obtenerDesplazamientoInicial()
+              << (correcto ? "" : "  <-- ERROR") << std::endl;
+    
+    delete sesion;
+    delete resincronizador;
+    return correcto;
+}
+
+/**
+ * @brief Copia el mensaje de la sesión antes de que el planificador la libere
+ */
+void guardarMensaje(int fd, SesionPRT7* sesion, void* contexto) {
+    (void)fd;
+    sesion->obtenerCarga()->copiarA(static_cast<char*>(contexto), 64);
+}
+
+/**
+ * @brief Decodifica el ejemplo desde un pipe con el planificador de un solo hilo
+ */
+bool probarPlanificador() {
+    char mensaje[64] = "";
+    int extremos[2];
+    if (pipe2(extremos, O_NONBLOCK | O_CLOEXEC) != 0) return false;
+    
+    PlanificadorDeSesiones* planificador = new PlanificadorDeSesiones(guardarMensaje, mensaje);
+    SesionPRT7* sesion = new SesionPRT7(1);
+    bool agregado = planificador->agregar(extremos[0], sesion);
+    if (!agregado) {
+        delete sesion;
+        close(extremos[0]);
+    }
+    ssize_t n = write(extremos[1], TRAMAS, sizeof(TRAMAS) - 1);
+    close(extremos[1]);
+    if (agregado) planificador->ejecutar();
+    
+    bool correcto = agregado && n == static_cast<ssize_t>(sizeof(TRAMAS) - 1) &&
+                    strcmp(mensaje, ESPERADO) == 0;
+    std::cout << "  planificador: \"" << mensaje << "\"" << (correcto ? "" : "  <-- ERROR") << std::endl;
+    
+    delete planificador;
+    return correcto;
+}
+
+/**
+ * @brief Función principal
+ */
+int main() {
+    std::cout << "Cliente de libprt7.so (cabeceras públicas):" << std::endl;
+    
+    VentanaDeCarga* ventana = new VentanaDeCarga(VentanaDeCarga::TAM_BLOQUE, nullptr);
+    MensajeEmpaquetado* empaquetado = new MensajeEmpaquetado();
+    
+    bool correcto = probarAlmacenamiento("nodos", nullptr, nullptr);
+    correcto = probarAlmacenamiento("ventana", ventana, nullptr) && correcto;
+    correcto = probarAlmacenamiento("empaquetado", nullptr, empaquetado) && correcto;
+    correcto = probarResincronizacion() && correcto;
+    correcto = probarPlanificador() && correcto;
+    
+    delete empaquetado;
+    delete ventana;
+    
+    std::cout << (correcto ? "✓ Las clases exportadas decodifican el ejemplo"
+                           : "✗ ERROR: Resultado distinto con las clases exportadas") << std::endl;
+    return correcto ? 0 : 1;
+}
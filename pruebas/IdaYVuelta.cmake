@@ -0,0 +1,61 @@
+# Ida y vuelta del codificador (ctest): --codificar y después --lote
+#
+# Codifica TEXTO con el OBJETIVO y el MAP_CADA dados, decodifica las
+# tramas en modo lote y compara cada mensaje ensamblado con la línea
+# correspondiente del texto. Cada línea del texto es una secuencia
+# (A-Z y espacio, sin líneas vacías).
+#
+# Uso: cmake -DPROGRAMA=<DecodificadorPRT7> -DTEXTO=<archivo> -DOBJETIVO=tramas|bytes
+#            -DMAP_CADA=<n> -DTRAMAS=<archivo de salida> -P IdaYVuelta.cmake
+
+execute_process(
+    COMMAND ${PROGRAMA} --codificar ${TEXTO} --objetivo ${OBJETIVO} --map-cada ${MAP_CADA}
+    OUTPUT_FILE ${TRAMAS}
+    RESULT_VARIABLE resultado
+)
+if(NOT resultado EQUAL 0)
+    message(FATAL_ERROR "--codificar terminó con ${resultado}")
+endif()
+
+execute_process(
+    COMMAND ${PROGRAMA} --lote ${TRAMAS}
+    OUTPUT_VARIABLE salida
+    RESULT_VARIABLE resultado
+)
+if(NOT resultado EQUAL 0)
+    message(FATAL_ERROR "--lote terminó con ${resultado}")
+endif()
+
+# Mensajes: la línea que sigue a cada encabezado
+string(REPLACE "\n" ";" lineasSalida "${salida}")
+set(mensajes "")
+set(tomarSiguiente FALSE)
+foreach(linea IN LISTS lineasSalida)
+    if(tomarSiguiente)
+        list(APPEND mensajes "${linea}")
+        set(tomarSiguiente FALSE)
+    elseif(linea STREQUAL "MENSAJE OCULTO ENSAMBLADO:")
+        set(tomarSiguiente TRUE)
+    endif()
+endforeach()
+
+file(READ ${TEXTO} texto)
+string(REGEX REPLACE "\n$" "" texto "${texto}")
+string(REPLACE "\n" ";" esperados "${texto}")
+
+list(LENGTH esperados numEsperados)
+list(LENGTH mensajes numMensajes)
+if(NOT numMensajes EQUAL numEsperados)
+    message(FATAL_ERROR "${numMensajes} mensajes decodificados, se esperaban ${numEsperados}")
+endif()
+
+math(EXPR ultimo "${numEsperados} - 1")
+foreach(k RANGE ${ultimo})
+    list(GET esperados ${k} esperado)
+    list(GET mensajes ${k} mensaje)
+    if(NOT mensaje STREQUAL esperado)
+        message(FATAL_ERROR "Secuencia ${k}: se decodificó \"${mensaje}\" en lugar de \"${esperado}\"")
+    endif()
+endforeach()
+
+message(STATUS "${numMensajes} secuencias idénticas al texto (objetivo ${OBJETIVO}, MAP cada ${MAP_CADA})")
@@ -0,0 +1,559 @@
+/**
+ * @file MedicionesPRT7.cpp
+ * @brief Mediciones de rendimiento de libprt7 (dispositivos simulados y perfiles seriales)
+ * 
+ * Programa aparte del cliente DecodificadorPRT7: simula muchos
+ * dispositivos en un solo hilo y mide los perfiles de lectura del
+ * puerto serial sobre una pty. Devuelve 1 si alguna secuencia llega
+ * incorrecta o algún dispositivo no cierra todas sus secuencias.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <thread>
+#include "CodificadorPRT7.h"
+#include "SesionPRT7.h"
+#include "PlanificadorDeSesiones.h"
+#include "PuertoSerial.h"
+
+/**
+ * @brief Contadores del modo de simulación (compartidos por todas las sesiones)
+ */
+struct ContextoSimulacion {
+    std::size_t longEsperada;            ///< Caracteres del mensaje de cada secuencia
+    unsigned long long tramasEsperadas;  ///< Tramas que debe recibir cada dispositivo
+    int marcadoresEsperados;             ///< Marcadores que debe recibir cada dispositivo
+    int cerrados;                        ///< Dispositivos verificados al cerrarse
+    unsigned long long secuencias;       ///< Secuencias terminadas
+    unsigned long long incorrectas;      ///< Secuencias o dispositivos con resultado distinto
+};
+
+/**
+ * @brief Cuenta las secuencias terminadas de los dispositivos simulados
+ */
+void contarSecuenciaSimulada(const EventoPRT7* evento, void* contexto) {
+    if (evento->tipo != EventoPRT7::FIN_SECUENCIA) return;
+    
+    ContextoSimulacion* ctx = static_cast<ContextoSimulacion*>(contexto);
+    ctx->secuencias++;
+    if (evento->longitudMensaje != ctx->longEsperada) ctx->incorrectas++;
+}
+
+/**
+ * @brief Verifica los contadores de un dispositivo simulado al cerrarse
+ * 
+ * Cada dispositivo debe haber recibido todas sus tramas sin errores y
+ * cerrado una secuencia por ronda (la sesión empieza en la secuencia 1
+ * y avanza una con cada marcador).
+ */
+void verificarDispositivoSimulado(int fd, SesionPRT7* sesion, void* contexto) {
+    (void)fd;
+    ContextoSimulacion* ctx = static_cast<ContextoSimulacion*>(contexto);
+    ctx->cerrados++;
+    if (sesion->obtenerErrores() != 0 || sesion->obtenerTramasTotales() != ctx->tramasEsperadas ||
+        sesion->obtenerNumSecuencia() != ctx->marcadoresEsperados + 1) {
+        ctx->incorrectas++;
+    }
+}
+
+/**
+ * @brief Memoria residente del proceso en bytes (de /proc/self/statm)
+ */
+long memoriaResidente() {
+    std::ifstream statm("/proc/self/statm");
+    long paginas = 0;
+    long residentes = 0;
+    statm >> paginas >> residentes;
+    return residentes * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Segundos de un reloj (monotónico o de CPU del proceso)
+ */
+double segundos(clockid_t reloj) {
+    struct timespec t;
+    clock_gettime(reloj, &t);
+    return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief Modo de simulación: muchos dispositivos en un solo hilo
+ * 
+ * Cada dispositivo es un pipe con su SesionPRT7 registrada en un
+ * PlanificadorDeSesiones. En cada ronda todos los dispositivos envían
+ * una secuencia completa y el planificador las decodifica. Mide la
+ * memoria residente por sesión y el rendimiento de un núcleo; solo se
+ * cronometra el ciclo del planificador, no la escritura simulada.
+ * 
+ * @param numDispositivos Dispositivos simulados
+ * @param rondas Secuencias que envía cada dispositivo
+ * @return Código de salida del programa
+ */
+int simularDispositivos(int numDispositivos, int rondas) {
+    // Cada dispositivo usa dos descriptores (los dos extremos del pipe)
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+        getrlimit(RLIMIT_NOFILE, &limite);
+    }
+    int maxDispositivos = static_cast<int>((limite.rlim_cur - 32) / 2);
+    if (numDispositivos > maxDispositivos) {
+        std::cerr << "[AVISO] Límite de descriptores " << limite.rlim_cur << ": se simulan "
+                  << maxDispositivos << " dispositivos" << std::endl;
+        numDispositivos = maxDispositivos;
+    }
+    
+    // Guion de cada secuencia: un mensaje codificado y el marcador de reinicio
+    static const char MENSAJE[] = "LECTURA DEL SENSOR SIMULADO SIN NOVEDAD";
+    CodificadorPRT7 codificador;
+    codificador.codificar(MENSAJE, sizeof(MENSAJE) - 1);
+    codificador.agregarReinicio();
+    const char* guion = codificador.obtenerSalida();
+    size_t longGuion = codificador.obtenerLongitud();
+    unsigned long long tramasGuion = codificador.obtenerTramasLoad() + codificador.obtenerTramasMap();
+    
+    ContextoSimulacion ctx;
+    ctx.longEsperada = sizeof(MENSAJE) - 1;
+    ctx.tramasEsperadas = tramasGuion * static_cast<unsigned long long>(rondas);
+    ctx.marcadoresEsperados = rondas;
+    ctx.cerrados = 0;
+    ctx.secuencias = 0;
+    ctx.incorrectas = 0;
+    
+    long memoriaInicial = memoriaResidente();
+    
+    PlanificadorDeSesiones* planificador = new PlanificadorDeSesiones(verificarDispositivoSimulado, &ctx);
+    int* escritores = new int[numDispositivos];
+    int creados = 0;
+    for (; creados < numDispositivos; creados++) {
+        int extremos[2];
+        if (pipe2(extremos, O_NONBLOCK | O_CLOEXEC) != 0) break;
+        
+        SesionPRT7* sesion = new SesionPRT7(1, contarSecuenciaSimulada, &ctx);
+        if (!planificador->agregar(extremos[0], sesion)) {
+            delete sesion;
+            close(extremos[0]);
+            close(extremos[1]);
+            break;
+        }
+        escritores[creados] = extremos[1];
+    }
+    if (creados == 0) {
+        std::cerr << "✗ ERROR: No se pudo crear ningún dispositivo simulado" << std::endl;
+        delete[] escritores;
+        delete planificador;
+        return 1;
+    }
+    
+    long memoriaSesiones = memoriaResidente();
+    
+    // Rondas: todos escriben su secuencia y el planificador drena todo
+    double reloj = 0.0;
+    double cpu = 0.0;
+    unsigned long long despertares = 0;
+    unsigned long long perdidos = 0;
+    for (int r = 0; r < rondas; r++) {
+        for (int i = 0; i < creados; i++) {
+            ssize_t n = write(escritores[i], guion, longGuion);
+            if (n != static_cast<ssize_t>(longGuion)) perdidos++;
+        }
+        
+        double inicioReloj = segundos(CLOCK_MONOTONIC);
+        double inicioCpu = segundos(CLOCK_PROCESS_CPUTIME_ID);
+        int atendidos;
+        while ((atendidos = planificador->atenderEventos(0)) > 0) {
+            despertares++;
+        }
+        reloj += segundos(CLOCK_MONOTONIC) - inicioReloj;
+        cpu += segundos(CLOCK_PROCESS_CPUTIME_ID) - inicioCpu;
+    }
+    
+    long memoriaPico = memoriaResidente();
+    
+    // Fin de datos: cada sesión se verifica y se libera al cerrar su pipe
+    for (int i = 0; i < creados; i++) {
+        close(escritores[i]);
+    }
+    planificador->ejecutar();
+    
+    double bytes = static_cast<double>(planificador->obtenerBytesLeidos());
+    double tramas = static_cast<double>(tramasGuion) * creados * rondas;
+    double bytesPorSegundo = (cpu > 0.0) ? bytes / cpu : 0.0;
+    
+    std::cout << "[SIMULACION] " << creados << " dispositivos, " << rondas << " rondas, "
+              << ctx.secuencias << " secuencias (" << ctx.incorrectas << " incorrectas, "
+              << perdidos << " escrituras incompletas)" << std::endl;
+    std::cout << "[SIMULACION] " << static_cast<unsigned long long>(tramas) << " tramas en "
+              << reloj << " s (" << cpu << " s de CPU, un hilo), "
+              << planificador->obtenerLecturas() << " lecturas, " << despertares << " despertares" << std::endl;
+    if (cpu > 0.0) {
+        std::cout << "[SIMULACION] Por núcleo: " << static_cast<unsigned long long>(tramas / cpu)
+                  << " tramas/s, " << static_cast<unsigned long long>(bytesPorSegundo / (1 << 20))
+                  << " MB/s, ~" << static_cast<unsigned long long>(bytesPorSegundo / 11520.0)
+                  << " dispositivos a 115200 baudios" << std::endl;
+    }
+    std::cout << "[SIMULACION] Memoria por sesión: "
+              << (memoriaSesiones - memoriaInicial) / creados << " bytes al crear, "
+              << (memoriaPico - memoriaInicial) / creados << " bytes tras decodificar"
+              << " (sin el buffer del pipe en el kernel)" << std::endl;
+    
+    // Todos los dispositivos cerrados y verificados, una secuencia por ronda
+    bool correcto = ctx.incorrectas == 0 && perdidos == 0 && ctx.cerrados == creados &&
+                    ctx.secuencias == static_cast<unsigned long long>(creados) * static_cast<unsigned long long>(rondas);
+    if (!correcto) {
+        std::cerr << "✗ ERROR: " << ctx.cerrados << " de " << creados << " dispositivos verificados, "
+                  << ctx.secuencias << " de " << static_cast<unsigned long long>(creados) * rondas
+                  << " secuencias terminadas" << std::endl;
+    }
+    
+    delete[] escritores;
+    delete planificador;
+    return correcto ? 0 : 1;
+}
+
+/**
+ * @brief Tiempos de llegada de las tramas LOAD en la medición por pty
+ */
+struct MedicionSerial {
+    double* llegada;   ///< Momento en que se decodificó cada trama
+    int recibidas;     ///< Tramas decodificadas
+    int capacidad;     ///< Tamaño de llegada
+};
+
+/**
+ * @brief Registra la llegada de cada trama LOAD decodificada
+ */
+void registrarLlegada(const EventoPRT7* evento, void* contexto) {
+    if (evento->tipo != EventoPRT7::CARGA) return;
+    
+    MedicionSerial* m = static_cast<MedicionSerial*>(contexto);
+    if (m->recibidas < m->capacidad) {
+        m->llegada[m->recibidas] = segundos(CLOCK_MONOTONIC);
+    }
+    m->recibidas++;
+}
+
+/**
+ * @brief Compara dos double para qsort
+ */
+int compararDouble(const void* a, const void* b) {
+    double x = *static_cast<const double*>(a);
+    double y = *static_cast<const double*>(b);
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/**
+ * @brief Envía tramas por el lado maestro de la pty (hilo emisor de la medición)
+ * @param fd Lado maestro (no bloqueante)
+ * @param envio Salida: momento de envío de cada trama (nullptr = ráfaga sin pausas)
+ * @param numTramas Tramas a enviar
+ * @param pausaUs Pausa entre tramas en microsegundos
+ */
+void emitirTramasPty(int fd, double* envio, int numTramas, int pausaUs) {
+    static const char TRAMA[] = "L,A\n";
+    
+    if (envio == nullptr) {
+        // Ráfaga: bloques grandes, tan rápido como la pty los acepte
+        const int TRAMAS_BLOQUE = 1024;
+        char* bloque = new char[TRAMAS_BLOQUE * 4];
+        for (int i = 0; i < TRAMAS_BLOQUE; i++) memcpy(bloque + 4 * i, TRAMA, 4);
+        
+        for (int enviadas = 0; enviadas < numTramas; enviadas += TRAMAS_BLOQUE) {
+            int k = numTramas - enviadas;
+            if (k > TRAMAS_BLOQUE) k = TRAMAS_BLOQUE;
+            const char* p = bloque;
+            size_t restante = static_cast<size_t>(k) * 4;
+            while (restante > 0) {
+                ssize_t n = write(fd, p, restante);
+                if (n > 0) {
+                    p += n;
+                    restante -= static_cast<size_t>(n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) continue;
+                
+                // Pty llena: esperar al lector; 5 s sin avance = el lector se rindió
+                struct pollfd pfd;
+                pfd.fd = fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                if (n == 0 || errno != EAGAIN || poll(&pfd, 1, 5000) <= 0) {
+                    delete[] bloque;
+                    return;
+                }
+            }
+        }
+        delete[] bloque;
+        return;
+    }
+    
+    for (int i = 0; i < numTramas; i++) {
+        envio[i] = segundos(CLOCK_MONOTONIC);
+        ssize_t n = write(fd, TRAMA, 4);
+        (void)n;
+        usleep(static_cast<useconds_t>(pausaUs));
+    }
+}
+
+/**
+ * @brief Resultado de medir un perfil de lectura sobre la pty
+ */
+struct ResultadoPerfil {
+    int tramasGoteo;          ///< Tramas enviadas en el goteo
+    int recibidasGoteo;       ///< Tramas decodificadas del goteo
+    int tramasRafaga;         ///< Tramas enviadas en la ráfaga
+    int recibidasRafaga;      ///< Tramas decodificadas de la ráfaga
+    double p50Us;             ///< Mediana de la latencia del goteo (us)
+    double bytesPorLectura;   ///< Promedio de bytes por read() en la ráfaga
+};
+
+/**
+ * @brief Lee de la pty hasta recibir las tramas o pasar 5 s sin datos
+ * 
+ * poll() antes de cada read() acota la espera aunque el perfil bloquee,
+ * así una trama perdida termina la medición en lugar de colgarla.
+ * 
+ * @return Número de read() con datos
+ */
+unsigned long long leerTramasPty(int fd, char* buffer, int tamLectura, SesionPRT7* sesion,
+                                 const MedicionSerial* m, int tramas) {
+    unsigned long long lecturas = 0;
+    while (m->recibidas < tramas) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int listo = poll(&pfd, 1, 5000);
+        if (listo == 0) break;  // Sin datos en 5 s: se perdieron tramas
+        if (listo < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        ssize_t n = read(fd, buffer, static_cast<size_t>(tamLectura));
+        if (n > 0) {
+            lecturas++;
+            sesion->alimentar(buffer, static_cast<size_t>(n));
+        } else if (n < 0 && errno != EINTR && errno != EAGAIN) {
+            break;
+        }
+    }
+    return lecturas;
+}
+
+/**
+ * @brief Mide un perfil de lectura sobre una pty
+ * 
+ * El lado esclavo se configura con configurarPuertoSerial() como un
+ * puerto real y se lee con el tamaño de read() del perfil. Primero un
+ * goteo de tramas espaciadas (latencia de cada trama desde que se
+ * escribe hasta que la sesión la decodifica) y después una ráfaga
+ * (rendimiento y bytes por read()).
+ * 
+ * @param perfil Perfil a medir
+ * @param baudios Velocidad configurada en la pty
+ * @param resultado Salida: tramas recibidas, latencia y bytes por read()
+ * @return false si no se pudo crear o configurar la pty
+ */
+bool medirPerfilPty(PerfilSerial perfil, int baudios, ResultadoPerfil* resultado) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        if (maestro >= 0) close(maestro);
+        return false;
+    }
+    
+    bool bajaLatencia = false;
+    int esclavo = configurarPuertoSerial(ptsname(maestro), baudios, perfil, &bajaLatencia);
+    if (esclavo < 0) {
+        close(maestro);
+        return false;
+    }
+    
+    // Maestro no bloqueante: si el lector deja de leer, el emisor se rinde
+    fcntl(maestro, F_SETFL, fcntl(maestro, F_GETFL) | O_NONBLOCK);
+    
+    const int TRAMAS_GOTEO = 1000;
+    const int PAUSA_US = 500;
+    const int TRAMAS_RAFAGA = 250000;
+    const int tamLectura = tamLecturaPerfil(perfil);
+    char* buffer = new char[tamLectura];
+    
+    // Goteo: latencia por trama
+    double* envio = new double[TRAMAS_GOTEO];
+    MedicionSerial m;
+    m.llegada = new double[TRAMAS_GOTEO];
+    m.recibidas = 0;
+    m.capacidad = TRAMAS_GOTEO;
+    
+    SesionPRT7* sesion = new SesionPRT7(1, registrarLlegada, &m);
+    std::thread emisor(emitirTramasPty, maestro, envio, TRAMAS_GOTEO, PAUSA_US);
+    leerTramasPty(esclavo, buffer, tamLectura, sesion, &m, TRAMAS_GOTEO);
+    emisor.join();
+    resultado->tramasGoteo = TRAMAS_GOTEO;
+    resultado->recibidasGoteo = m.recibidas;
+    
+    double* latencias = new double[TRAMAS_GOTEO];
+    int medidas = m.recibidas < TRAMAS_GOTEO ? m.recibidas : TRAMAS_GOTEO;
+    for (int i = 0; i < medidas; i++) {
+        latencias[i] = (m.llegada[i] - envio[i]) * 1e6;
+    }
+    qsort(latencias, static_cast<size_t>(medidas), sizeof(double), compararDouble);
+    resultado->p50Us = (medidas > 0) ? latencias[medidas / 2] : 0.0;
+    
+    // Ráfaga: rendimiento
+    m.recibidas = 0;
+    m.capacidad = 0;
+    sesion->reiniciar();
+    double inicio = segundos(CLOCK_MONOTONIC);
+    std::thread rafaga(emitirTramasPty, maestro, static_cast<double*>(nullptr), TRAMAS_RAFAGA, 0);
+    unsigned long long lecturas = leerTramasPty(esclavo, buffer, tamLectura, sesion, &m, TRAMAS_RAFAGA);
+    double duracion = segundos(CLOCK_MONOTONIC) - inicio;
+    resultado->tramasRafaga = TRAMAS_RAFAGA;
+    resultado->recibidasRafaga = m.recibidas;
+    resultado->bytesPorLectura = (lecturas > 0) ? static_cast<double>(m.recibidas) * 4 / lecturas : 0.0;
+    
+    rafaga.join();
+    
+    std::cout << "[SERIAL] Perfil " << nombrePerfil(perfil) << " (" << baudios << " baudios, "
+              << (perfil == PERFIL_BAJA_LATENCIA ? (bajaLatencia ? "ASYNC_LOW_LATENCY activo"
+                                                                 : "ASYNC_LOW_LATENCY no soportado")
+                                                 : "latencia del driver sin cambios")
+              << ", read() de " << tamLectura << ")" << std::endl;
+    if (medidas > 0) {
+        std::cout << "[SERIAL]   Latencia por trama: p50 " << static_cast<long>(latencias[medidas / 2])
+                  << " us, p99 " << static_cast<long>(latencias[(medidas * 99) / 100])
+                  << " us, máx " << static_cast<long>(latencias[medidas - 1]) << " us ("
+                  << medidas << " de " << TRAMAS_GOTEO << " tramas cada " << PAUSA_US << " us)" << std::endl;
+    }
+    if (duracion > 0.0 && lecturas > 0) {
+        std::cout << "[SERIAL]   Ráfaga: " << static_cast<unsigned long long>(m.recibidas / duracion)
+                  << " tramas/s, " << m.recibidas << " de " << TRAMAS_RAFAGA << " tramas, "
+                  << lecturas << " read() (" << static_cast<unsigned long long>(resultado->bytesPorLectura)
+                  << " bytes por read())" << std::endl;
+    }
+    
+    delete sesion;
+    delete[] latencias;
+    delete[] m.llegada;
+    delete[] envio;
+    delete[] buffer;
+    close(esclavo);
+    close(maestro);
+    return true;
+}
+
+/**
+ * @brief Modo de medición: compara los tres perfiles de lectura sobre una pty
+ * 
+ * La pty no limita la velocidad, así que mide el costo de despertar y
+ * de cada read() en el receptor; en un adaptador USB real hay que
+ * sumar el temporizador del adaptador, que es lo que baja
+ * ASYNC_LOW_LATENCY.
+ * 
+ * Falla si algún perfil pierde tramas, si la mediana de la latencia no
+ * queda muy por debajo del VTIME de 1 s del perfil clásico (100 ms), o
+ * si el perfil de volumen no junta más bytes por read() que el clásico.
+ * 
+ * @param baudios Velocidad configurada en la pty
+ * @return Código de salida del programa
+ */
+int medirPerfilesSerial(int baudios) {
+    const PerfilSerial PERFILES[] = { PERFIL_CLASICO, PERFIL_BAJA_LATENCIA, PERFIL_VOLUMEN };
+    const int NUM_PERFILES = static_cast<int>(sizeof(PERFILES) / sizeof(PERFILES[0]));
+    const double P50_MAXIMO_US = 100000.0;
+    
+    ResultadoPerfil resultados[NUM_PERFILES];
+    int fallos = 0;
+    for (int i = 0; i < NUM_PERFILES; i++) {
+        if (!medirPerfilPty(PERFILES[i], baudios, &resultados[i])) {
+            std::cerr << "✗ ERROR: No se pudo crear una pty para medir el perfil "
+                      << nombrePerfil(PERFILES[i]) << std::endl;
+            return 1;
+        }
+        
+        const ResultadoPerfil& r = resultados[i];
+        if (r.recibidasGoteo != r.tramasGoteo || r.recibidasRafaga != r.tramasRafaga) {
+            std::cerr << "✗ ERROR: El perfil " << nombrePerfil(PERFILES[i]) << " perdió tramas" << std::endl;
+            fallos++;
+        } else if (r.p50Us >= P50_MAXIMO_US) {
+            std::cerr << "✗ ERROR: El perfil " << nombrePerfil(PERFILES[i]) << " tiene p50 de "
+                      << static_cast<long>(r.p50Us) << " us (máximo " << static_cast<long>(P50_MAXIMO_US)
+                      << " us)" << std::endl;
+            fallos++;
+        }
+    }
+    
+    if (resultados[2].bytesPorLectura <= resultados[0].bytesPorLectura) {
+        std::cerr << "✗ ERROR: El perfil volumen no junta más bytes por read() que el clásico" << std::endl;
+        fallos++;
+    }
+    if (fallos == 0) {
+        std::cout << "✓ Ningún perfil pierde tramas y todos responden por debajo de "
+                  << static_cast<long>(P50_MAXIMO_US / 1000) << " ms" << std::endl;
+    }
+    
+    return (fallos == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Muestra las mediciones disponibles
+ */
+void mostrarUso() {
+    std::cerr << "Uso: prt7_mediciones <medición>" << std::endl;
+    std::cerr << "  --simular <n>              Mide n dispositivos simulados en un solo hilo" << std::endl;
+    std::cerr << "  --rondas <n>               Con --simular: secuencias por dispositivo (por defecto: 100)" << std::endl;
+    std::cerr << "  --medir-serial             Mide latencia y rendimiento de cada perfil sobre una pty" << std::endl;
+    std::cerr << "  --baudios <n>              Con --medir-serial: velocidad de la pty (por defecto: 115200)" << std::endl;
+}
+
+/**
+ * @brief Función principal: corre la medición pedida
+ */
+int main(int argc, char* argv[]) {
+    int numSimulados = 0;
+    int rondas = 100;
+    bool medirSerial = false;
+    int baudios = 115200;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--simular") == 0 && i + 1 < argc) {
+            numSimulados = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rondas") == 0 && i + 1 < argc) {
+            rondas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--medir-serial") == 0) {
+            medirSerial = true;
+        } else if (strcmp(argv[i], "--baudios") == 0 && i + 1 < argc) {
+            baudios = atoi(argv[++i]);
+            speed_t velocidad;
+            if (!velocidadTermios(baudios, &velocidad)) {
+                std::cerr << "[ERROR] Velocidad no soportada: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "[ERROR] Opción inválida: " << argv[i] << std::endl;
+            mostrarUso();
+            return 1;
+        }
+    }
+    
+    if (medirSerial) {
+        return medirPerfilesSerial(baudios);
+    }
+    if (numSimulados > 0 && rondas > 0) {
+        return simularDispositivos(numSimulados, rondas);
+    }
+    mostrarUso();
+    return 1;
+}
@@ -0,0 +1,897 @@
+/**
+ * @file PruebasPRT7.cpp
+ * @brief Verificaciones de libprt7 sin hardware (ctest)
+ * 
+ * Cada opción corre una verificación de punta a punta contra la
+ * biblioteca estática y devuelve 0 solo si el resultado coincide con
+ * lo esperado. No forman parte del cliente DecodificadorPRT7.
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <thread>
+#include "ServidorPRT7.h"
+#include "CodificadorPRT7.h"
+#include "ResincronizadorPRT7.h"
+#include "VentanaDeCarga.h"
+#include "MensajeEmpaquetado.h"
+#include "ListaDeCarga.h"
+#include "SesionPRT7.h"
+#include "BufferDeTramas.h"
+#include "CascadaDeRotores.h"
+#include "DecodificadorParalelo.h"
+
+/**
+ * @brief Ejecuta el ciclo del servidor de verificación en su propio hilo
+ */
+void ejecutarServidor(ServidorPRT7* servidor) {
+    servidor->ejecutar();
+}
+
+/**
+ * @brief Cliente de las verificaciones del servidor: envía tramas y lee la respuesta
+ * 
+ * Envía y lee a la vez con poll() pero en bloques pequeños, así que el
+ * servidor acumula respuestas y pasa por la pausa de lectura. Cierra
+ * su lado de escritura al terminar de enviar y lee hasta que el
+ * servidor cierra la conexión.
+ * 
+ * @param puerto Puerto TCP del servidor en 127.0.0.1
+ * @param tramas Texto PRT-7 a enviar
+ * @param longTramas Bytes a enviar
+ * @param respuesta Destino de la respuesta
+ * @param capRespuesta Tamaño de respuesta (llenarlo cuenta como fallo)
+ * @param recibidos Salida: bytes recibidos
+ * @return false si no hubo conexión, avance en 5 s o espacio para la respuesta
+ */
+bool intercambiarConServidor(int puerto, const char* tramas, size_t longTramas,
+                             char* respuesta, size_t capRespuesta, size_t* recibidos) {
+    *recibidos = 0;
+    
+    struct sockaddr_in direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons(static_cast<unsigned short>(puerto));
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool conectado = fd >= 0 &&
+                     connect(fd, reinterpret_cast<struct sockaddr*>(&direccion), sizeof(direccion)) == 0;
+    
+    // Enviar en bloques grandes y leer en bloques pequeños
+    const size_t BLOQUE_ENVIO = 65536;
+    const size_t BLOQUE_LECTURA = 512;
+    size_t enviados = 0;
+    bool fallo = !conectado;
+    
+    if (conectado) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    
+    while (!fallo) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN | (enviados < longTramas ? POLLOUT : 0);
+        pfd.revents = 0;
+        if (poll(&pfd, 1, 5000) <= 0) {
+            fallo = true;  // Sin avance en 5 s
+            break;
+        }
+        
+        if ((pfd.revents & POLLOUT) && enviados < longTramas) {
+            size_t n = longTramas - enviados;
+            if (n > BLOQUE_ENVIO) n = BLOQUE_ENVIO;
+            ssize_t r = send(fd, tramas + enviados, n, MSG_NOSIGNAL);
+            if (r > 0) {
+                enviados += static_cast<size_t>(r);
+                if (enviados == longTramas) shutdown(fd, SHUT_WR);
+            } else if (r < 0 && errno != EAGAIN && errno != EINTR) {
+                fallo = true;
+            }
+        }
+        
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            size_t n = BLOQUE_LECTURA;
+            if (n > capRespuesta - *recibidos) n = capRespuesta - *recibidos;
+            ssize_t r = recv(fd, respuesta + *recibidos, n, 0);
+            if (r > 0) {
+                *recibidos += static_cast<size_t>(r);
+                if (*recibidos == capRespuesta) fallo = true;  // Más de lo esperado
+            } else if (r == 0) {
+                break;  // El servidor cerró: respondió todo
+            } else if (errno != EAGAIN && errno != EINTR) {
+                fallo = true;
+            }
+        }
+    }
+    
+    if (fd >= 0) close(fd);
+    return !fallo;
+}
+
+/**
+ * @brief Verifica el servidor TCP de punta a punta sin hardware
+ * 
+ * Genera mensajes pseudoaleatorios (A-Z y espacio), los codifica con
+ * CodificadorPRT7 (forzando tramas MAP) y los envía a un ServidorPRT7 en
+ * 127.0.0.1 por un puerto elegido por el sistema (con
+ * intercambiarConServidor). La respuesta debe ser exactamente el texto
+ * original: un mensaje por línea.
+ * 
+ * @return 0 si la respuesta coincide
+ */
+int verificarServidor() {
+    const int NUM_MENSAJES = 2000;
+    const int MAX_LONGITUD = 400;
+    
+    // Texto plano: cada '\n' es un marcador de reinicio al codificar
+    size_t capTexto = static_cast<size_t>(NUM_MENSAJES) * (MAX_LONGITUD + 1);
+    char* texto = new char[capTexto];
+    size_t longTexto = 0;
+    unsigned int semilla = 12345;
+    for (int m = 0; m < NUM_MENSAJES; m++) {
+        semilla = semilla * 1103515245u + 12345u;
+        int longitud = 1 + static_cast<int>((semilla >> 16) % MAX_LONGITUD);
+        for (int k = 0; k < longitud; k++) {
+            semilla = semilla * 1103515245u + 12345u;
+            int simbolo = static_cast<int>((semilla >> 16) % 27);
+            texto[longTexto++] = (simbolo == 26) ? ' ' : static_cast<char>('A' + simbolo);
+        }
+        texto[longTexto++] = '\n';
+    }
+    
+    CodificadorPRT7* codificador = new CodificadorPRT7(CodificadorPRT7::MINIMO_TRAMAS, 3);
+    codificador->codificar(texto, longTexto);
+    const char* tramas = codificador->obtenerSalida();
+    size_t longTramas = codificador->obtenerLongitud();
+    
+    ServidorPRT7* servidor = new ServidorPRT7();
+    int puerto = servidor->escucharTcp(0);
+    if (puerto < 0) {
+        std::cerr << "✗ ERROR: No se pudo escuchar en 127.0.0.1" << std::endl;
+        delete servidor;
+        delete codificador;
+        delete[] texto;
+        return 1;
+    }
+    std::thread hiloServidor(ejecutarServidor, servidor);
+    
+    char* respuesta = new char[longTexto + 1];
+    size_t recibidos = 0;
+    bool fallo = !intercambiarConServidor(puerto, tramas, longTramas, respuesta, longTexto + 1, &recibidos);
+    
+    servidor->detener();
+    hiloServidor.join();
+    
+    bool coincide = !fallo && recibidos == longTexto && memcmp(respuesta, texto, longTexto) == 0;
+    
+    std::cout << "Tramas enviadas: " << longTramas << " bytes ("
+              << codificador->obtenerTramasLoad() << " LOAD, "
+              << codificador->obtenerTramasMap() << " MAP)" << std::endl;
+    std::cout << "Respuesta: " << recibidos << " de " << longTexto << " bytes, "
+              << servidor->obtenerMensajesEnviados() << " mensajes" << std::endl;
+    std::cout << (coincide ? "✓ El servidor respondió exactamente el texto original"
+                           : "✗ ERROR: La respuesta del servidor no coincide") << std::endl;
+    
+    delete[] respuesta;
+    delete servidor;
+    delete codificador;
+    delete[] texto;
+    
+    return coincide ? 0 : 1;
+}
+
+/**
+ * @brief Veredicto de la primera secuencia completa en verificarResincronizacion
+ */
+struct ResultadoResincronizacion {
+    int finSecuencias;   ///< Eventos FIN_SECUENCIA recibidos
+    int veredicto;       ///< Veredicto del segundo FIN_SECUENCIA
+};
+
+/**
+ * @brief Guarda el veredicto que llega con FIN_SECUENCIA
+ */
+void anotarVeredicto(const EventoPRT7* evento, void* contexto) {
+    ResultadoResincronizacion* r = static_cast<ResultadoResincronizacion*>(contexto);
+    if (evento->tipo == EventoPRT7::FIN_SECUENCIA) {
+        r->finSecuencias++;
+        r->veredicto = evento->veredicto;
+    }
+}
+
+/**
+ * @brief Conecta a mitad de una secuencia con resincronización y ventana
+ * 
+ * Alimenta una SesionPRT7 como lo hace decodificarSerial con
+ * --resincronizar: las tramas parciales, un marcador, el guion completo
+ * y otro marcador. Compara el veredicto, el desplazamiento y el mensaje
+ * corregido contra lo esperado.
+ * 
+ * @return true si todo coincide
+ */
+bool probarResincronizacion(const char* parcial, size_t longParcial, const char* guion,
+                            size_t longGuion, size_t capacidadVentana, int veredictoEsperado,
+                            int desplazamientoEsperado, const char* esperado, size_t longEsperado) {
+    const char* marcador = "--- REINICIANDO SECUENCIA ---\n";
+    
+    ResultadoResincronizacion resultado;
+    resultado.finSecuencias = 0;
+    resultado.veredicto = ResincronizadorPRT7::PENDIENTE;
+    
+    VentanaDeCarga* ventana = (capacidadVentana > 0) ? new VentanaDeCarga(capacidadVentana, nullptr) : nullptr;
+    ResincronizadorPRT7* resincronizador = new ResincronizadorPRT7();
+    SesionPRT7* sesion = new SesionPRT7(1, anotarVeredicto, &resultado);
+    sesion->setVentana(ventana);
+    sesion->setResincronizador(resincronizador);
+    
+    sesion->alimentar(parcial, longParcial);
+    sesion->alimentar(marcador, strlen(marcador));
+    sesion->alimentar(guion, longGuion);
+    sesion->alimentar(marcador, strlen(marcador));
+    
+    bool correcto = resultado.finSecuencias == 2 &&
+                    resultado.veredicto == veredictoEsperado &&
+                    resincronizador->obtenerDesplazamientoInicial() == desplazamientoEsperado;
+    if (correcto && veredictoEsperado == ResincronizadorPRT7::CORREGIDO) {
+        correcto = resincronizador->obtenerLongCorregido() == longEsperado &&
+                   memcmp(resincronizador->obtenerCorregido(), esperado, longEsperado) == 0;
+    }
+    
+    delete sesion;
+    delete resincronizador;
+    delete ventana;
+    return correcto;
+}
+
+/**
+ * @brief Verifica la resincronización con la ventana de memoria fija
+ * 
+ * El mensaje provisional no puede salir de la lista de la sesión: con
+ * --ventana solo guarda los últimos caracteres. Dos casos, con y sin
+ * ventana:
+ * - una secuencia parcial de solo espacios con el rotor en 5 (la salida
+ *   provisional ya era correcta: CONFIRMADO);
+ * - un texto generado y codificado con tramas MAP, conectando en varias
+ *   tramas (CORREGIDO con el sufijo del texto, o CONFIRMADO si el rotor
+ *   estaba en 'A').
+ * 
+ * @param capacidadVentana Caracteres de la ventana
+ * @return 0 si todos los casos coinciden
+ */
+int verificarResincronizacion(size_t capacidadVentana) {
+    const int NUM_ESPACIOS = 3 * static_cast<int>(VentanaDeCarga::TAM_BLOQUE);
+    const int LONG_TEXTO = 3 * static_cast<int>(VentanaDeCarga::TAM_BLOQUE);
+    const char* space = "L,Space\n";
+    const size_t longSpace = strlen(space);
+    int casos = 0;
+    int fallos = 0;
+    
+    // Caso 1: "L,A", "M,5" y después solo espacios
+    size_t longEspacios = static_cast<size_t>(NUM_ESPACIOS) * longSpace;
+    char* espacios = new char[longEspacios];
+    for (int i = 0; i < NUM_ESPACIOS; i++) {
+        memcpy(espacios + static_cast<size_t>(i) * longSpace, space, longSpace);
+    }
+    const char* inicio = "L,A\nM,5\n";
+    size_t longInicio = strlen(inicio);
+    char* guionEspacios = new char[longInicio + longEspacios];
+    memcpy(guionEspacios, inicio, longInicio);
+    memcpy(guionEspacios + longInicio, espacios, longEspacios);
+    
+    for (int v = 0; v < 2; v++) {
+        casos++;
+        if (!probarResincronizacion(espacios, longEspacios, guionEspacios, longInicio + longEspacios,
+                                    v == 0 ? 0 : capacidadVentana, ResincronizadorPRT7::CONFIRMADO,
+                                    5, nullptr, 0)) {
+            fallos++;
+        }
+    }
+    delete[] guionEspacios;
+    delete[] espacios;
+    
+    // Caso 2: texto pseudoaleatorio codificado con un MAP cada 3 cargas
+    char* texto = new char[LONG_TEXTO + 1];
+    unsigned int semilla = 777;
+    for (int k = 0; k < LONG_TEXTO; k++) {
+        semilla = semilla * 1103515245u + 12345u;
+        int simbolo = static_cast<int>((semilla >> 16) % 27);
+        texto[k] = (simbolo == 26) ? ' ' : static_cast<char>('A' + simbolo);
+    }
+    texto[LONG_TEXTO] = '\n';
+    
+    CodificadorPRT7* codificador = new CodificadorPRT7(CodificadorPRT7::MINIMO_TRAMAS, 3);
+    codificador->codificar(texto, static_cast<size_t>(LONG_TEXTO) + 1);
+    const char* guion = codificador->obtenerSalida();
+    size_t longGuion = codificador->obtenerLongitud();
+    const char* fin = strstr(guion, "---");  // El guion sin su marcador
+    if (fin != nullptr) longGuion = static_cast<size_t>(fin - guion);
+    
+    // Conectar al inicio de varias tramas: el mensaje esperado es el
+    // texto desde la primera carga recibida
+    size_t cargasAntes = 0;
+    long long rotacionAntes = 0;
+    int linea = 0;
+    for (size_t pos = 0; pos < longGuion; linea++) {
+        const char* salto = static_cast<const char*>(memchr(guion + pos, '\n', longGuion - pos));
+        size_t finLinea = (salto != nullptr) ? static_cast<size_t>(salto - guion) + 1 : longGuion;
+        
+        if (linea > 0 && linea % 997 == 0) {
+            int desplazamiento = static_cast<int>(((rotacionAntes % 27) + 27) % 27);
+            int veredicto = (desplazamiento == 0) ? ResincronizadorPRT7::CONFIRMADO
+                                                  : ResincronizadorPRT7::CORREGIDO;
+            for (int v = 0; v < 2; v++) {
+                casos++;
+                if (!probarResincronizacion(guion + pos, longGuion - pos, guion, longGuion,
+                                            v == 0 ? 0 : capacidadVentana, veredicto, desplazamiento,
+                                            texto + cargasAntes, static_cast<size_t>(LONG_TEXTO) - cargasAntes)) {
+                    fallos++;
+                }
+            }
+        }
+        
+        if (guion[pos] == 'L') cargasAntes++;
+        if (guion[pos] == 'M') rotacionAntes += atoi(guion + pos + 2);
+        pos = finLinea;
+    }
+    
+    delete codificador;
+    delete[] texto;
+    
+    std::cout << "Resincronización con ventana de " << capacidadVentana << " caracteres: "
+              << (casos - fallos) << " de " << casos << " casos correctos" << std::endl;
+    std::cout << (fallos == 0 ? "✓ Los veredictos no dependen de la ventana"
+                              : "✗ ERROR: Veredicto o mensaje corregido incorrecto") << std::endl;
+    
+    return (fallos == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Campos de todas las secuencias de una sesión, uno detrás de otro
+ */
+struct CapturaDeCampos {
+    SesionPRT7* sesion;        ///< Sesión que entrega los eventos
+    char* campos[2];           ///< Índice ListaDeCarga::Campo
+    std::size_t longitud[2];   ///< Caracteres capturados de cada campo
+    std::size_t capacidad;     ///< Tamaño de cada buffer
+    bool archivar;             ///< Repetir cada secuencia con MensajeEmpaquetado::agregarLista
+    int diferencias;           ///< Secuencias en que agregarLista no devolvió lo mismo
+};
+
+/**
+ * @brief Copia los dos campos de cada secuencia terminada
+ * 
+ * Con archivar también empaqueta la lista de nodos por bloques y
+ * compara lo que devuelve contra la lista.
+ */
+void capturarCampos(const EventoPRT7* evento, void* contexto) {
+    if (evento->tipo != EventoPRT7::FIN_SECUENCIA) return;
+    
+    CapturaDeCampos* c = static_cast<CapturaDeCampos*>(contexto);
+    const ListaDeCarga* carga = c->sesion->obtenerCarga();
+    MensajeEmpaquetado* archivo = c->archivar ? new MensajeEmpaquetado() : nullptr;
+    if (archivo != nullptr) archivo->agregarLista(*carga);
+    
+    for (int campo = 0; campo < 2; campo++) {
+        ListaDeCarga::Campo k = static_cast<ListaDeCarga::Campo>(campo);
+        char* destino = c->campos[campo] + c->longitud[campo];
+        std::size_t n = carga->copiarA(destino, c->capacidad - c->longitud[campo], k);
+        
+        if (archivo != nullptr) {
+            char* copia = new char[n + 1];
+            if (archivo->copiarA(copia, n + 1, k) != n || memcmp(copia, destino, n) != 0) {
+                c->diferencias++;
+            }
+            delete[] copia;
+        }
+        c->longitud[campo] += n;
+    }
+    delete archivo;
+}
+
+/**
+ * @brief Verifica que el modo empaquetado devuelve lo mismo que la lista de nodos
+ * 
+ * Tramas pseudoaleatorias con mayúsculas, minúsculas, espacios, dígitos
+ * y signos, repartidas en secuencias, se decodifican con nodos y con
+ * --empaquetar entregando los bytes en tramos de tamaño variable. Los
+ * dos campos deben coincidir: el decodificado ya viene plegado por el
+ * rotor y el codificado conserva las minúsculas recibidas. Cada
+ * secuencia de nodos se empaqueta además por bloques con agregarLista.
+ * 
+ * @return 0 si los dos modos coinciden
+ */
+int verificarEmpaquetado() {
+    const int NUM_TRAMAS = 50000;
+    static const char SIMBOLOS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789.,;!?-#";
+    const int NUM_SIMBOLOS = static_cast<int>(sizeof(SIMBOLOS) - 1);
+    const char* marcador = "--- REINICIANDO SECUENCIA ---\n";
+    
+    // Guion: tramas LOAD con cualquier símbolo, alguna MAP y algún marcador
+    std::size_t capGuion = static_cast<std::size_t>(NUM_TRAMAS) * 32;
+    char* guion = new char[capGuion];
+    std::size_t longGuion = 0;
+    unsigned int semilla = 2024;
+    for (int t = 0; t < NUM_TRAMAS; t++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        if (azar % 997 == 0) {
+            memcpy(guion + longGuion, marcador, strlen(marcador));
+            longGuion += strlen(marcador);
+        } else if (azar % 7 == 0) {
+            longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "M,%d\n",
+                                                          static_cast<int>((azar >> 3) % 61) - 30));
+        } else if (azar % 11 == 0) {
+            memcpy(guion + longGuion, "L,Space\n", 8);
+            longGuion += 8;
+        } else {
+            guion[longGuion++] = 'L';
+            guion[longGuion++] = ',';
+            guion[longGuion++] = SIMBOLOS[(azar >> 4) % NUM_SIMBOLOS];
+            guion[longGuion++] = '\n';
+        }
+    }
+    
+    MensajeEmpaquetado* empaquetado = new MensajeEmpaquetado();
+    CapturaDeCampos capturas[2];
+    for (int m = 0; m < 2; m++) {
+        CapturaDeCampos& c = capturas[m];
+        c.capacidad = static_cast<std::size_t>(NUM_TRAMAS) + 1;
+        c.campos[0] = new char[c.capacidad];
+        c.campos[1] = new char[c.capacidad];
+        c.longitud[0] = 0;
+        c.longitud[1] = 0;
+        c.archivar = (m == 0);
+        c.diferencias = 0;
+        c.sesion = new SesionPRT7(1, capturarCampos, &c);
+        if (m == 1) c.sesion->setEmpaquetado(empaquetado);
+        
+        std::size_t pos = 0;
+        unsigned int tramo = 7;
+        while (pos < longGuion) {
+            tramo = tramo * 1103515245u + 12345u;
+            std::size_t n = 1 + (tramo >> 16) % 300;
+            if (n > longGuion - pos) n = longGuion - pos;
+            c.sesion->alimentar(guion + pos, n);
+            pos += n;
+        }
+        c.sesion->finalizar();
+        EventoPRT7 fin;
+        memset(&fin, 0, sizeof(fin));
+        fin.tipo = EventoPRT7::FIN_SECUENCIA;
+        capturarCampos(&fin, &c);  // Última secuencia (sin marcador)
+    }
+    
+    bool coincide = capturas[0].diferencias == 0;
+    for (int campo = 0; campo < 2; campo++) {
+        coincide = coincide && capturas[0].longitud[campo] == capturas[1].longitud[campo] &&
+                   memcmp(capturas[0].campos[campo], capturas[1].campos[campo], capturas[0].longitud[campo]) == 0;
+    }
+    std::size_t minusculas = 0;
+    for (std::size_t i = 0; i < capturas[1].longitud[ListaDeCarga::CODIFICADO]; i++) {
+        char c = capturas[1].campos[ListaDeCarga::CODIFICADO][i];
+        if (c >= 'a' && c <= 'z') minusculas++;
+    }
+    
+    std::cout << "Empaquetado: " << capturas[0].longitud[ListaDeCarga::DECODIFICADO]
+              << " caracteres, " << minusculas << " minúsculas en el campo codificado, "
+              << capturas[0].diferencias << " secuencias distintas con agregarLista" << std::endl;
+    std::cout << (coincide && minusculas > 0 ? "✓ Nodos y empaquetado devuelven los mismos dos campos"
+                                             : "✗ ERROR: El modo empaquetado no devuelve lo mismo que los nodos")
+              << std::endl;
+    
+    for (int m = 0; m < 2; m++) {
+        delete capturas[m].sesion;
+        delete[] capturas[m].campos[0];
+        delete[] capturas[m].campos[1];
+    }
+    delete empaquetado;
+    delete[] guion;
+    
+    return (coincide && minusculas > 0) ? 0 : 1;
+}
+
+/**
+ * @brief Recorre un campo con los iteradores y lo compara con copiarA
+ * 
+ * Hacia adelante desde begin() y hacia atrás desde end(), con el mismo
+ * número de pasos que caracteres exporta copiarA.
+ * 
+ * @return true si los dos recorridos devuelven lo mismo que copiarA
+ */
+bool compararIteradores(const ListaDeCarga* carga, ListaDeCarga::Campo campo, std::size_t* recorridos) {
+    std::size_t n = carga->obtenerCopiables(campo);
+    char* copia = new char[n + 1];
+    bool correcto = carga->copiarA(copia, n + 1, campo) == n;
+    
+    bool codificado = (campo == ListaDeCarga::CODIFICADO);
+    ListaDeCarga::Iterador inicio = codificado ? carga->beginCodificado() : carga->begin();
+    ListaDeCarga::Iterador fin = codificado ? carga->endCodificado() : carga->end();
+    
+    std::size_t k = 0;
+    for (ListaDeCarga::Iterador it = inicio; it != fin && correcto; ++it, k++) {
+        correcto = k < n && *it == copia[k];
+    }
+    correcto = correcto && k == n;
+    
+    ListaDeCarga::Iterador it = fin;
+    while (correcto && k > 0) {
+        --it;
+        k--;
+        correcto = *it == copia[k];
+    }
+    correcto = correcto && it == inicio;
+    
+    *recorridos += n;
+    delete[] copia;
+    return correcto;
+}
+
+/**
+ * @brief Verifica los iteradores de ListaDeCarga con nodos, ventana y empaquetado
+ * 
+ * Una secuencia larga de tramas (con minúsculas y signos, que el
+ * empaquetado guarda como excepciones) se decodifica en cada modo:
+ * nodos, empaquetado, ventana con segmento en disco y ventana sin
+ * segmento (pierde el principio al derramar). En todos los modos los
+ * iteradores deben recorrer exactamente lo que exporta copiarA, y el
+ * campo decodificado de los modos completos debe coincidir con los nodos.
+ * 
+ * @return 0 si todos los recorridos coinciden
+ */
+int verificarIteradores() {
+    const int NUM_TRAMAS = 20000;
+    static const char SIMBOLOS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcxyz0.,?";
+    const int NUM_SIMBOLOS = static_cast<int>(sizeof(SIMBOLOS) - 1);
+    
+    std::size_t capGuion = static_cast<std::size_t>(NUM_TRAMAS) * 16;
+    char* guion = new char[capGuion];
+    std::size_t longGuion = 0;
+    unsigned int semilla = 4242;
+    for (int t = 0; t < NUM_TRAMAS; t++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        if (azar % 9 == 0) {
+            longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "M,%d\n",
+                                                          static_cast<int>((azar >> 4) % 53) - 26));
+        } else if (azar % 13 == 0) {
+            memcpy(guion + longGuion, "L,Space\n", 8);
+            longGuion += 8;
+        } else {
+            longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "L,%c\n",
+                                                          SIMBOLOS[(azar >> 4) % NUM_SIMBOLOS]));
+        }
+    }
+    
+    char rutaSegmento[] = "/tmp/prt7_iteradores_XXXXXX";
+    int fdSegmento = mkstemp(rutaSegmento);
+    if (fdSegmento < 0) {
+        std::cerr << "✗ ERROR: No se pudo crear el segmento temporal" << std::endl;
+        delete[] guion;
+        return 1;
+    }
+    close(fdSegmento);
+    
+    const char* NOMBRES[4] = {"nodos", "empaquetado", "ventana con segmento", "ventana sin segmento"};
+    MensajeEmpaquetado* empaquetado = new MensajeEmpaquetado();
+    VentanaDeCarga* conSegmento = new VentanaDeCarga(VentanaDeCarga::TAM_BLOQUE, rutaSegmento);
+    VentanaDeCarga* sinSegmento = new VentanaDeCarga(VentanaDeCarga::TAM_BLOQUE, nullptr);
+    
+    char* referencia = nullptr;
+    std::size_t longReferencia = 0;
+    int fallos = 0;
+    for (int modo = 0; modo < 4; modo++) {
+        SesionPRT7* sesion = new SesionPRT7(1);
+        if (modo == 1) sesion->setEmpaquetado(empaquetado);
+        if (modo == 2) sesion->setVentana(conSegmento);
+        if (modo == 3) sesion->setVentana(sinSegmento);
+        sesion->alimentar(guion, longGuion);
+        sesion->finalizar();
+        
+        const ListaDeCarga* carga = sesion->obtenerCarga();
+        std::size_t recorridos = 0;
+        bool correcto = compararIteradores(carga, ListaDeCarga::DECODIFICADO, &recorridos) &&
+                        compararIteradores(carga, ListaDeCarga::CODIFICADO, &recorridos);
+        
+        // Los modos que no pierden nada devuelven el mismo mensaje que los nodos
+        std::size_t n = carga->obtenerCopiables();
+        char* mensaje = new char[n + 1];
+        carga->copiarA(mensaje, n + 1);
+        if (modo == 0) {
+            referencia = mensaje;
+            longReferencia = n;
+        } else {
+            if (modo < 3) {
+                correcto = correcto && n == longReferencia && memcmp(mensaje, referencia, n) == 0;
+            } else {
+                correcto = correcto && n < longReferencia;  // Sin segmento se pierde el principio
+            }
+            delete[] mensaje;
+        }
+        
+        if (!correcto) fallos++;
+        std::cout << "  " << NOMBRES[modo] << ": " << recorridos << " caracteres recorridos"
+                  << (correcto ? "" : " (distinto de copiarA)") << std::endl;
+        delete sesion;
+    }
+    std::cout << (fallos == 0 ? "✓ Los iteradores recorren lo mismo que copiarA en los cuatro modos"
+                              : "✗ ERROR: Algún iterador no recorre el mensaje") << std::endl;
+    
+    delete[] referencia;
+    delete sinSegmento;
+    delete conSegmento;
+    delete empaquetado;
+    unlink(rutaSegmento);
+    delete[] guion;
+    
+    return (fallos == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Mensajes de una verificación de rotores, uno por línea
+ */
+struct SalidaDeRotores {
+    SesionPRT7* sesion;      ///< Sesión que entrega los eventos (solo con SesionPRT7)
+    char* texto;             ///< Mensajes seguidos de '\n'
+    std::size_t longitud;    ///< Caracteres escritos
+    std::size_t capacidad;   ///< Tamaño de texto
+};
+
+/**
+ * @brief Agrega un mensaje y su fin de línea a la salida
+ */
+void anotarMensaje(SalidaDeRotores* s, const ListaDeCarga* carga) {
+    if (carga->estaVacia()) return;
+    std::size_t n = carga->copiarA(s->texto + s->longitud, s->capacidad - s->longitud);
+    s->longitud += n;
+    if (s->longitud < s->capacidad) s->texto[s->longitud++] = '\n';
+}
+
+/**
+ * @brief FIN_SECUENCIA de SesionPRT7 en verificarRotores
+ */
+void anotarMensajeSesion(const EventoPRT7* evento, void* contexto) {
+    if (evento->tipo != EventoPRT7::FIN_SECUENCIA) return;
+    SalidaDeRotores* s = static_cast<SalidaDeRotores*>(contexto);
+    anotarMensaje(s, s->sesion->obtenerCarga());
+}
+
+/**
+ * @brief Fin de secuencia de BufferDeTramas en verificarRotores
+ */
+void anotarMensajeBuffer(const ListaDeCarga* carga, void* contexto) {
+    anotarMensaje(static_cast<SalidaDeRotores*>(contexto), carga);
+}
+
+/**
+ * @brief Fin de secuencia de DecodificadorParalelo en verificarRotores
+ */
+void anotarMensajeParalelo(const char* mensaje, std::size_t longitud, void* contexto) {
+    SalidaDeRotores* s = static_cast<SalidaDeRotores*>(contexto);
+    if (longitud + 1 > s->capacidad - s->longitud) {
+        s->longitud = s->capacidad;  // No cabe: cuenta como diferencia
+        return;
+    }
+    memcpy(s->texto + s->longitud, mensaje, longitud);
+    s->longitud += longitud;
+    s->texto[s->longitud++] = '\n';
+}
+
+/**
+ * @brief Verifica --rotores en todos los caminos de decodificación
+ * 
+ * Genera tramas L,X, M,N, M1,N y M2,N pseudoaleatorias para una cascada
+ * de 3 rotores, con alguna trama M3,N (rotor inexistente) y marcadores.
+ * El resultado esperado sale de un modelo independiente de la cascada
+ * (cada rotor suma su rotación módulo 27; el espacio no se rota) y se
+ * compara contra SesionPRT7, BufferDeTramas con CascadaDeRotores,
+ * DecodificadorParalelo y ServidorPRT7: un mensaje por línea.
+ * 
+ * @return 0 si los cuatro caminos coinciden con el modelo
+ */
+int verificarRotores() {
+    const int NUM_ROTORES = 3;
+    const int NUM_TRAMAS = 60000;
+    const char* marcador = "--- REINICIANDO SECUENCIA ---\n";
+    
+    std::size_t capGuion = static_cast<std::size_t>(NUM_TRAMAS) * 32;
+    char* guion = new char[capGuion];
+    std::size_t longGuion = 0;
+    char* esperado = new char[NUM_TRAMAS + 1];
+    std::size_t longEsperado = 0;
+    std::size_t inicioSecuencia = 0;
+    int rotacion[NUM_ROTORES] = {0, 0, 0};
+    int invalidas = 0;
+    unsigned int semilla = 31337;
+    
+    for (int t = 0; t < NUM_TRAMAS; t++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        bool ultima = (t == NUM_TRAMAS - 1);
+        
+        if (ultima || azar % 499 == 0) {
+            memcpy(guion + longGuion, marcador, strlen(marcador));
+            longGuion += strlen(marcador);
+            if (longEsperado > inicioSecuencia) esperado[longEsperado++] = '\n';
+            inicioSecuencia = longEsperado;
+            for (int r = 0; r < NUM_ROTORES; r++) rotacion[r] = 0;
+        } else if (azar % 5 == 0) {
+            int rotor = static_cast<int>((azar >> 3) % (NUM_ROTORES + 1));
+            int n = static_cast<int>((azar >> 5) % 121) - 60;
+            if (rotor == NUM_ROTORES && (azar >> 9) % 8 != 0) rotor = 0;
+            if (rotor == 0 && (azar >> 12) % 2 == 0) {
+                longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "M,%d\n", n));
+            } else {
+                longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "M%d,%d\n", rotor, n));
+            }
+            if (rotor < NUM_ROTORES) {
+                rotacion[rotor] = ((rotacion[rotor] + n) % 27 + 27) % 27;
+            } else {
+                invalidas++;
+            }
+        } else {
+            int simbolo = static_cast<int>((azar >> 4) % 27);
+            if (simbolo == 26) {
+                memcpy(guion + longGuion, "L,Space\n", 8);
+                longGuion += 8;
+            } else {
+                longGuion += static_cast<std::size_t>(sprintf(guion + longGuion, "L,%c\n", 'A' + simbolo));
+            }
+            
+            // Modelo: rotor 0, luego 1, luego 2; el espacio sale igual
+            for (int r = 0; r < NUM_ROTORES && simbolo != 26; r++) {
+                simbolo = (simbolo + rotacion[r]) % 27;
+            }
+            esperado[longEsperado++] = (simbolo == 26) ? ' ' : static_cast<char>('A' + simbolo);
+        }
+    }
+    
+    const char* NOMBRES[4] = {"SesionPRT7", "BufferDeTramas", "DecodificadorParalelo", "ServidorPRT7"};
+    SalidaDeRotores salidas[4];
+    for (int k = 0; k < 4; k++) {
+        salidas[k].sesion = nullptr;
+        salidas[k].capacidad = longEsperado + 1;
+        salidas[k].texto = new char[salidas[k].capacidad];
+        salidas[k].longitud = 0;
+    }
+    
+    // SesionPRT7 por tramos de tamaño variable
+    salidas[0].sesion = new SesionPRT7(NUM_ROTORES, anotarMensajeSesion, &salidas[0]);
+    std::size_t pos = 0;
+    unsigned int tramo = 11;
+    while (pos < longGuion) {
+        tramo = tramo * 1103515245u + 12345u;
+        std::size_t n = 1 + (tramo >> 16) % 300;
+        if (n > longGuion - pos) n = longGuion - pos;
+        salidas[0].sesion->alimentar(guion + pos, n);
+        pos += n;
+    }
+    salidas[0].sesion->finalizar();
+    delete salidas[0].sesion;
+    
+    // BufferDeTramas con una cascada
+    BufferDeTramas* buffer = new BufferDeTramas(1024, NUM_ROTORES);
+    buffer->parsearBloque(guion, longGuion);
+    buffer->finalizar();
+    CascadaDeRotores* cascada = new CascadaDeRotores(NUM_ROTORES);
+    ListaDeCarga* carga = new ListaDeCarga();
+    buffer->ejecutar(carga, cascada, anotarMensajeBuffer, &salidas[1]);
+    int erroresBuffer = buffer->obtenerErrores();
+    delete carga;
+    delete cascada;
+    delete buffer;
+    
+    // DecodificadorParalelo
+    DecodificadorParalelo* paralelo = new DecodificadorParalelo(4, NUM_ROTORES);
+    int erroresParalelo = paralelo->decodificar(guion, longGuion, anotarMensajeParalelo, &salidas[2]);
+    delete paralelo;
+    
+    // ServidorPRT7 por TCP
+    ServidorPRT7* servidor = new ServidorPRT7(NUM_ROTORES);
+    int puerto = servidor->escucharTcp(0);
+    bool servidorListo = puerto >= 0;
+    if (servidorListo) {
+        std::thread hiloServidor(ejecutarServidor, servidor);
+        servidorListo = intercambiarConServidor(puerto, guion, longGuion, salidas[3].texto,
+                                                salidas[3].capacidad, &salidas[3].longitud);
+        servidor->detener();
+        hiloServidor.join();
+    }
+    delete servidor;
+    
+    int fallos = 0;
+    std::cout << "Cascada de " << NUM_ROTORES << " rotores: " << longGuion << " bytes de tramas, "
+              << longEsperado << " caracteres esperados, " << invalidas << " tramas M" << NUM_ROTORES
+              << ",N" << std::endl;
+    for (int k = 0; k < 4; k++) {
+        bool coincide = salidas[k].longitud == longEsperado &&
+                        memcmp(salidas[k].texto, esperado, longEsperado) == 0;
+        if (k == 1) coincide = coincide && erroresBuffer == invalidas;
+        if (k == 2) coincide = coincide && erroresParalelo == invalidas;
+        if (k == 3) coincide = coincide && servidorListo;
+        if (!coincide) fallos++;
+        std::cout << "  " << NOMBRES[k] << ": " << salidas[k].longitud << " caracteres"
+                  << (coincide ? "" : " (distinto)") << std::endl;
+        delete[] salidas[k].texto;
+    }
+    std::cout << (fallos == 0 ? "✓ Los cuatro caminos decodifican la cascada como el modelo"
+                              : "✗ ERROR: Algún camino no respeta --rotores") << std::endl;
+    
+    delete[] esperado;
+    delete[] guion;
+    
+    return (fallos == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Muestra las verificaciones disponibles
+ */
+void mostrarUso() {
+    std::cerr << "Uso: prt7_pruebas <verificación>" << std::endl;
+    std::cerr << "  --servidor                 Envía una captura generada al servidor TCP y compara la respuesta" << std::endl;
+    std::cerr << "  --resincronizacion         Conecta a mitad de secuencia con resincronización y ventana" << std::endl;
+    std::cerr << "  --empaquetado              Compara los dos campos del modo empaquetado contra la lista de nodos" << std::endl;
+    std::cerr << "  --iteradores               Recorre el mensaje con iteradores con nodos, ventana y empaquetado" << std::endl;
+    std::cerr << "  --rotores                  Decodifica tramas M<k>,N de 3 rotores por todos los caminos" << std::endl;
+    std::cerr << "  --ventana <n>              Con --resincronizacion: caracteres de la ventana (por defecto: 4096)" << std::endl;
+}
+
+/**
+ * @brief Función principal: corre la verificación pedida
+ */
+int main(int argc, char* argv[]) {
+    bool servidor = false;
+    bool resincronizacion = false;
+    bool empaquetado = false;
+    bool rotores = false;
+    bool iteradores = false;
+    long capacidadVentana = static_cast<long>(VentanaDeCarga::TAM_BLOQUE);
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--servidor") == 0) {
+            servidor = true;
+        } else if (strcmp(argv[i], "--resincronizacion") == 0) {
+            resincronizacion = true;
+        } else if (strcmp(argv[i], "--empaquetado") == 0) {
+            empaquetado = true;
+        } else if (strcmp(argv[i], "--iteradores") == 0) {
+            iteradores = true;
+        } else if (strcmp(argv[i], "--rotores") == 0) {
+            rotores = true;
+        } else if (strcmp(argv[i], "--ventana") == 0 && i + 1 < argc) {
+            capacidadVentana = atol(argv[++i]);
+        } else {
+            std::cerr << "[ERROR] Opción inválida: " << argv[i] << std::endl;
+            mostrarUso();
+            return 1;
+        }
+    }
+    
+    if (servidor) {
+        return verificarServidor();
+    }
+    if (empaquetado) {
+        return verificarEmpaquetado();
+    }
+    if (iteradores) {
+        return verificarIteradores();
+    }
+    if (rotores) {
+        return verificarRotores();
+    }
+    if (resincronizacion && capacidadVentana > 0) {
+        return verificarResincronizacion(static_cast<size_t>(capacidadVentana));
+    }
+    mostrarUso();
+    return 1;
+}
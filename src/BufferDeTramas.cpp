@@ -0,0 +1,366 @@
+/**
+ * @file BufferDeTramas.cpp
+ * @brief Implementación del buffer de tramas por lotes
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "BufferDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "Trazas.h"
+#include <cstring>
+#include <cstdlib>
+
+/**
+ * Verifica si el dato de una trama LOAD es la palabra "space" (sin importar mayúsculas)
+ */
+static bool esPalabraSpace(const char* dato, int longitud) {
+    const char* palabra = "SPACE";
+    if (longitud != 5) return false;
+    for (int i = 0; i < 5; i++) {
+        char c = (dato[i] >= 'a' && dato[i] <= 'z') ? dato[i] - 32 : dato[i];
+        if (c != palabra[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * Símbolos del alfabeto: una trama MAPEO_ROTOR guarda indice * 27 + rotación
+ */
+static const int TAM_ALFABETO = 27;
+
+/**
+ * Dígitos máximos del índice de rotor (igual que SesionPRT7)
+ */
+static const int MAX_DIGITOS_ROTOR = 4;
+
+/**
+ * Constructor de BufferDeTramas
+ */
+BufferDeTramas::BufferDeTramas(int capacidadInicial, int rotores)
+    : etiquetas(nullptr), cargas(nullptr), numTramas(0),
+      capacidad(capacidadInicial < 16 ? 16 : capacidadInicial), errores(0),
+      numRotores(rotores < 1 ? 1 : rotores), longPendiente(0) {
+    etiquetas = new unsigned char[capacidad];
+    cargas = new int[capacidad];
+}
+
+/**
+ * Destructor de BufferDeTramas
+ */
+BufferDeTramas::~BufferDeTramas() {
+    delete[] etiquetas;
+    delete[] cargas;
+    etiquetas = nullptr;
+    cargas = nullptr;
+}
+
+/**
+ * Agrega una trama al final de los arreglos
+ */
+void BufferDeTramas::agregar(unsigned char etiqueta, int carga) {
+    if (numTramas == capacidad) {
+        int nuevaCapacidad = capacidad * 2;
+        unsigned char* nuevasEtiquetas = new unsigned char[nuevaCapacidad];
+        int* nuevasCargas = new int[nuevaCapacidad];
+        memcpy(nuevasEtiquetas, etiquetas, numTramas * sizeof(unsigned char));
+        memcpy(nuevasCargas, cargas, numTramas * sizeof(int));
+        delete[] etiquetas;
+        delete[] cargas;
+        etiquetas = nuevasEtiquetas;
+        cargas = nuevasCargas;
+        capacidad = nuevaCapacidad;
+    }
+    
+    etiquetas[numTramas] = etiqueta;
+    cargas[numTramas] = carga;
+    numTramas++;
+}
+
+/**
+ * Parsea una línea completa con las mismas reglas que procesarLinea()
+ */
+void BufferDeTramas::agregarLinea(const char* linea, int longitud) {
+    if (longitud <= 0) return;
+    
+    // Copiar a un buffer terminado en '\0' para poder usar strstr/atoi
+    char copia[MAX_LINEA];
+    if (longitud >= MAX_LINEA) longitud = MAX_LINEA - 1;
+    memcpy(copia, linea, longitud);
+    copia[longitud] = '\0';
+    
+    if (strstr(copia, "REINICIANDO SECUENCIA") != nullptr) {
+        agregar(REINICIO, 0);
+        return;
+    }
+    
+    char tipo = copia[0];
+    
+    if ((tipo == 'L' || tipo == 'l') && copia[1] == ',') {
+        const char* dato = copia + 2;
+        int longDato = longitud - 2;
+        
+        if (esPalabraSpace(dato, longDato)) {
+            agregar(CARGA, ' ');
+        } else if (longDato > 0) {
+            agregar(CARGA, static_cast<unsigned char>(dato[0]));
+        } else {
+            errores++;
+        }
+    } else if (tipo == 'M' || tipo == 'm') {
+        // "M,N" o "Mk,N" (k = índice de rotor, acotado en dígitos como en SesionPRT7)
+        const char* coma = copia + 1;
+        int indiceRotor = 0;
+        int digitos = 0;
+        while (*coma >= '0' && *coma <= '9') {
+            if (++digitos > MAX_DIGITOS_ROTOR) break;
+            indiceRotor = indiceRotor * 10 + (*coma - '0');
+            coma++;
+        }
+        
+        if (*coma != ',') {
+            // Igual que el bucle principal: no es una trama, se ignora
+            if (coma != copia + 1) errores++;
+            return;
+        }
+        
+        // Rotor inexistente
+        if (indiceRotor >= numRotores) {
+            errores++;
+            return;
+        }
+        
+        int rotacion = atoi(coma + 1);
+        if (indiceRotor == 0) {
+            agregar(MAPEO, rotacion);
+        } else {
+            int reducida = ((rotacion % TAM_ALFABETO) + TAM_ALFABETO) % TAM_ALFABETO;
+            agregar(MAPEO_ROTOR, indiceRotor * TAM_ALFABETO + reducida);
+        }
+    }
+    // Cualquier otra línea (---, texto, etc.) se ignora
+}
+
+/**
+ * Parsea un bloque de texto
+ */
+int BufferDeTramas::parsearBloque(const char* bloque, std::size_t longitud) {
+    if (bloque == nullptr) return 0;
+    PRT7_TRAZA("BufferDeTramas::parsearBloque");
+    
+    int antes = numTramas;
+    std::size_t inicio = 0;
+    
+    for (std::size_t i = 0; i < longitud; i++) {
+        if (bloque[i] != '\n' && bloque[i] != '\r') continue;
+        
+        if (longPendiente > 0) {
+            // Completar la línea que quedó partida en el bloque anterior
+            std::size_t resto = i - inicio;
+            if (resto > static_cast<std::size_t>(MAX_LINEA - 1 - longPendiente)) {
+                resto = MAX_LINEA - 1 - longPendiente;
+            }
+            memcpy(pendiente + longPendiente, bloque + inicio, resto);
+            agregarLinea(pendiente, longPendiente + static_cast<int>(resto));
+            longPendiente = 0;
+        } else {
+            agregarLinea(bloque + inicio, static_cast<int>(i - inicio));
+        }
+        
+        inicio = i + 1;
+    }
+    
+    // Guardar el fragmento final sin salto de línea
+    if (inicio < longitud) {
+        std::size_t resto = longitud - inicio;
+        if (resto > static_cast<std::size_t>(MAX_LINEA - 1 - longPendiente)) {
+            resto = MAX_LINEA - 1 - longPendiente;
+        }
+        memcpy(pendiente + longPendiente, bloque + inicio, resto);
+        longPendiente += static_cast<int>(resto);
+    }
+    
+    return numTramas - antes;
+}
+
+/**
+ * Parsea la línea pendiente
+ */
+int BufferDeTramas::finalizar() {
+    int antes = numTramas;
+    if (longPendiente > 0) {
+        agregarLinea(pendiente, longPendiente);
+        longPendiente = 0;
+    }
+    return numTramas - antes;
+}
+
+/**
+ * Ejecuta el buffer en un solo ciclo con despacho estático
+ */
+int BufferDeTramas::ejecutar(ListaDeCarga* carga, RotorDeMapeo* rotor,
+                             FinDeSecuencia fin, void* contexto) const {
+    if (carga == nullptr || rotor == nullptr) return 0;
+    PRT7_TRAZA("BufferDeTramas::ejecutar");
+    
+    // Tabla de mapeo memorizada para el estado actual del rotor (0 = sin calcular)
+    char tabla[256];
+    memset(tabla, 0, sizeof(tabla));
+    
+    int i = 0;
+    while (i < numTramas) {
+        switch (etiquetas[i]) {
+            case CARGA: {
+                // Racha de LOADs: el rotor no cambia, se reutiliza la tabla
+                while (i < numTramas && etiquetas[i] == CARGA) {
+                    unsigned char c = static_cast<unsigned char>(cargas[i]);
+                    if (tabla[c] == 0) {
+                        tabla[c] = rotor->getMapeo(static_cast<char>(c));
+                    }
+                    carga->insertarAlFinal(static_cast<char>(c), tabla[c]);
+                    i++;
+                }
+                break;
+            }
+            
+            case MAPEO: {
+                // Fusionar MAPs consecutivos en una sola rotación
+                long total = 0;
+                while (i < numTramas && etiquetas[i] == MAPEO) {
+                    total += cargas[i];
+                    i++;
+                }
+                rotor->rotar(static_cast<int>(total % 27));
+                memset(tabla, 0, sizeof(tabla));
+                break;
+            }
+            
+            case REINICIO: {
+                if (fin != nullptr && !carga->estaVacia()) {
+                    fin(carga, contexto);
+                }
+                carga->vaciar();
+                rotor->reiniciar();
+                memset(tabla, 0, sizeof(tabla));
+                i++;
+                break;
+            }
+            
+            default:
+                i++;
+                break;
+        }
+    }
+    
+    return numTramas;
+}
+
+/**
+ * Ejecuta el buffer sobre una cascada de rotores
+ */
+int BufferDeTramas::ejecutar(ListaDeCarga* carga, CascadaDeRotores* cascada,
+                             FinDeSecuencia fin, void* contexto) const {
+    if (carga == nullptr || cascada == nullptr) return 0;
+    PRT7_TRAZA("BufferDeTramas::ejecutar");
+    
+    int i = 0;
+    while (i < numTramas) {
+        switch (etiquetas[i]) {
+            case CARGA: {
+                // La cascada ya consulta una tabla compuesta de 27 entradas
+                while (i < numTramas && etiquetas[i] == CARGA) {
+                    char c = static_cast<char>(cargas[i]);
+                    carga->insertarAlFinal(c, cascada->getMapeo(c));
+                    i++;
+                }
+                break;
+            }
+            
+            case MAPEO:
+            case MAPEO_ROTOR: {
+                // La tabla compuesta se recalcula una vez, en la siguiente carga
+                while (i < numTramas && (etiquetas[i] == MAPEO || etiquetas[i] == MAPEO_ROTOR)) {
+                    cascada->rotar(getIndiceRotor(i), getRotacion(i) % TAM_ALFABETO);
+                    i++;
+                }
+                break;
+            }
+            
+            case REINICIO: {
+                if (fin != nullptr && !carga->estaVacia()) {
+                    fin(carga, contexto);
+                }
+                carga->vaciar();
+                cascada->reiniciar();
+                i++;
+                break;
+            }
+            
+            default:
+                i++;
+                break;
+        }
+    }
+    
+    return numTramas;
+}
+
+/**
+ * Elimina todas las tramas
+ */
+void BufferDeTramas::limpiar() {
+    numTramas = 0;
+    errores = 0;
+}
+
+/**
+ * Obtiene el número de tramas
+ */
+int BufferDeTramas::obtenerNumTramas() const {
+    return numTramas;
+}
+
+/**
+ * Obtiene el número de tramas mal formadas
+ */
+int BufferDeTramas::obtenerErrores() const {
+    return errores;
+}
+
+/**
+ * Obtiene la etiqueta de la trama i
+ */
+BufferDeTramas::Etiqueta BufferDeTramas::getEtiqueta(int i) const {
+    return static_cast<Etiqueta>(etiquetas[i]);
+}
+
+/**
+ * Obtiene la carga de la trama i
+ */
+int BufferDeTramas::getCarga(int i) const {
+    return cargas[i];
+}
+
+/**
+ * Obtiene el rotor de una trama MAP
+ */
+int BufferDeTramas::getIndiceRotor(int i) const {
+    return (etiquetas[i] == MAPEO_ROTOR) ? cargas[i] / TAM_ALFABETO : 0;
+}
+
+/**
+ * Obtiene la rotación de una trama MAP
+ */
+int BufferDeTramas::getRotacion(int i) const {
+    return (etiquetas[i] == MAPEO_ROTOR) ? cargas[i] % TAM_ALFABETO : cargas[i];
+}
+
+/**
+ * Obtiene el número de rotores
+ */
+int BufferDeTramas::obtenerNumRotores() const {
+    return numRotores;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file CascadaDeRotores.cpp
+ * @brief Implementación de la cascada de rotores
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "CascadaDeRotores.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * Constructor de CascadaDeRotores
+ * Crea n rotores nuevos
+ */
+CascadaDeRotores::CascadaDeRotores(int n) : rotores(nullptr), numRotores(n < 1 ? 1 : n),
+                                            tablaValida(false) {
+    rotores = new RotorDeMapeo*[numRotores];
+    for (int i = 0; i < numRotores; i++) {
+        rotores[i] = new RotorDeMapeo();
+    }
+}
+
+/**
+ * Destructor de CascadaDeRotores
+ * Libera cada rotor y el arreglo
+ */
+CascadaDeRotores::~CascadaDeRotores() {
+    for (int i = 0; i < numRotores; i++) {
+        delete rotores[i];
+    }
+    delete[] rotores;
+    rotores = nullptr;
+    numRotores = 0;
+}
+
+/**
+ * Recalcula la tabla compuesta
+ * Cada símbolo del alfabeto pasa por todos los rotores en orden
+ */
+void CascadaDeRotores::recalcularTabla() const {
+    for (int i = 0; i < TAM_ALFABETO; i++) {
+        char c = (i < 26) ? static_cast<char>('A' + i) : ' ';
+        for (int r = 0; r < numRotores; r++) {
+            c = rotores[r]->getMapeo(c);
+        }
+        tabla[i] = c;
+    }
+    tablaValida = true;
+}
+
+/**
+ * Rota un rotor de la cascada e invalida la tabla
+ */
+bool CascadaDeRotores::rotar(int indice, int n) {
+    if (indice < 0 || indice >= numRotores) return false;
+    
+    rotores[indice]->rotar(n);
+    tablaValida = false;
+    return true;
+}
+
+/**
+ * Reinicia cada rotor e invalida la tabla
+ */
+void CascadaDeRotores::reiniciar() {
+    for (int i = 0; i < numRotores; i++) {
+        rotores[i]->reiniciar();
+    }
+    tablaValida = false;
+}
+
+/**
+ * Obtiene el carácter mapeado por toda la cascada
+ */
+char CascadaDeRotores::getMapeo(char in) const {
+    // Convertir a mayúsculas si es minúscula
+    if (in >= 'a' && in <= 'z') {
+        in = in - 'a' + 'A';
+    }
+    
+    int indice;
+    if (in >= 'A' && in <= 'Z') {
+        indice = in - 'A';
+    } else if (in == ' ') {
+        indice = 26;
+    } else {
+        return in;
+    }
+    
+    if (!tablaValida) {
+        recalcularTabla();
+    }
+    
+    return tabla[indice];
+}
+
+/**
+ * Obtiene un rotor de la cascada
+ */
+const RotorDeMapeo* CascadaDeRotores::getRotor(int indice) const {
+    if (indice < 0 || indice >= numRotores) return nullptr;
+    return rotores[indice];
+}
+
+/**
+ * Obtiene el número de rotores
+ */
+int CascadaDeRotores::obtenerNumRotores() const {
+    return numRotores;
+}
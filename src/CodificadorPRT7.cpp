@@ -0,0 +1,381 @@
+/**
+ * @file CodificadorPRT7.cpp
+ * @brief Implementación del codificador PRT-7 y su planificador de rotaciones
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "CodificadorPRT7.h"
+#include <cstring>
+
+/**
+ * Costo "infinito" (combinación no válida)
+ * 
+ * Cabe tres veces en un int: costo acumulado de un bloque (< 2^30) +
+ * MAP + carga nunca desborda aunque los tres sean infinitos.
+ */
+static const int INFINITO = 1 << 29;
+
+/**
+ * Marca de "sin rotación" en la tabla de decisiones
+ */
+static const unsigned char SIN_ROTACION = 255;
+
+/**
+ * Símbolo de un carácter de texto plano: 0-25 letras, 26 espacio,
+ * -1 otro carácter (se envía tal cual), -2 ignorado ('\r')
+ */
+static inline int simboloPlano(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c == ' ') return 26;
+    if (c == '\r') return -2;
+    return -1;
+}
+
+/**
+ * Valor N más corto de una trama M,N que avanza 'delta' posiciones (1..26)
+ */
+static inline int valorMap(int delta) {
+    int negativo = delta - 27;  // -26 .. -1
+    int bytesPos = (delta >= 10) ? 2 : 1;
+    int bytesNeg = ((negativo <= -10) ? 2 : 1) + 1;
+    return (bytesNeg < bytesPos) ? negativo : delta;
+}
+
+/**
+ * Bytes de la trama "M,N\n" para un avance de 'delta' posiciones
+ */
+static inline int bytesMap(int delta) {
+    int n = valorMap(delta);
+    int digitos = (n >= 10 || n <= -10) ? 2 : 1;
+    return 2 + digitos + (n < 0 ? 1 : 0) + 1;
+}
+
+/**
+ * Bytes de la trama LOAD para el símbolo y con desplazamiento p (0 = imposible)
+ */
+static inline int bytesCarga(int p, int y) {
+    if (y == -2) return 0;
+    if (y == -1) return 4;                    // "L,c\n"
+    if (y == 26) return (p == 0) ? 8 : 4;     // "L,Space\n" o una letra
+    return ((y - p + 27) % 27 == 26) ? 0 : 4; // La letra p-1 no se puede producir
+}
+
+/**
+ * Constructor de CodificadorPRT7
+ */
+CodificadorPRT7::CodificadorPRT7(Objetivo obj, int mapCadaN)
+    : objetivo(obj), cargasPorMap(mapCadaN < 0 ? 0 : mapCadaN), desplazamiento(0),
+      cargasDesdeMap(0), salida(nullptr), longSalida(0), capSalida(0),
+      tramasLoad(0), tramasMap(0), origen(nullptr) {
+    // Decisiones por carácter y desplazamiento + ruta elegida por carácter
+    origen = new unsigned char[BLOQUE * TAM_ALFABETO + BLOQUE];
+    
+    // Pesos: criterio principal x1000 + criterio secundario
+    const int pesoTrama = (objetivo == MINIMO_TRAMAS) ? 1000 : 1;
+    const int pesoByte = (objetivo == MINIMO_BYTES) ? 1000 : 1;
+    
+    // Tablas de costos para que el ciclo de planificación solo sume y compare
+    // (la tabla de MAP va duplicada para leer una ventana contigua por estado de origen)
+    for (int delta = 0; delta < TAM_ALFABETO; delta++) {
+        int c = (delta == 0) ? INFINITO : pesoTrama + pesoByte * bytesMap(delta);
+        costoMap[delta] = c;
+        costoMap[delta + TAM_ALFABETO] = c;
+    }
+    for (int y = -1; y < TAM_ALFABETO; y++) {
+        for (int p = 0; p < TAM_ALFABETO; p++) {
+            int bytes = bytesCarga(p, y);
+            costoCarga[y + 1][p] = (bytes == 0) ? INFINITO : pesoTrama + pesoByte * bytes;
+        }
+    }
+}
+
+/**
+ * Destructor de CodificadorPRT7
+ */
+CodificadorPRT7::~CodificadorPRT7() {
+    delete[] salida;
+    delete[] origen;
+}
+
+/**
+ * Asegura espacio para 'extra' bytes más en la salida
+ */
+void CodificadorPRT7::reservar(std::size_t extra) {
+    if (longSalida + extra <= capSalida) return;
+    
+    std::size_t nuevaCap = (capSalida == 0) ? 4096 : capSalida * 2;
+    while (nuevaCap < longSalida + extra) nuevaCap *= 2;
+    
+    char* nueva = new char[nuevaCap];
+    if (longSalida > 0) memcpy(nueva, salida, longSalida);
+    delete[] salida;
+    salida = nueva;
+    capSalida = nuevaCap;
+}
+
+/**
+ * Copia texto a la salida
+ */
+void CodificadorPRT7::emitirTexto(const char* texto, std::size_t n) {
+    reservar(n);
+    memcpy(salida + longSalida, texto, n);
+    longSalida += n;
+}
+
+/**
+ * Emite la trama LOAD que produce el carácter c con el desplazamiento actual
+ */
+void CodificadorPRT7::emitirCarga(char c) {
+    int y = simboloPlano(c);
+    if (y == -2) return;
+    
+    reservar(8);
+    char* p = salida + longSalida;
+    
+    if (y == 26 && desplazamiento == 0) {
+        memcpy(p, "L,Space\n", 8);
+        longSalida += 8;
+    } else {
+        char enviado;
+        if (y == -1) {
+            enviado = c;
+        } else if (y == 26) {
+            enviado = static_cast<char>('A' + (26 - desplazamiento));
+        } else {
+            enviado = static_cast<char>('A' + (y - desplazamiento + 27) % 27);
+        }
+        p[0] = 'L';
+        p[1] = ',';
+        p[2] = enviado;
+        p[3] = '\n';
+        longSalida += 4;
+    }
+    
+    tramasLoad++;
+}
+
+/**
+ * Emite una trama M,N
+ */
+void CodificadorPRT7::emitirMap(int n) {
+    reservar(8);
+    char* p = salida + longSalida;
+    int i = 0;
+    p[i++] = 'M';
+    p[i++] = ',';
+    if (n < 0) {
+        p[i++] = '-';
+        n = -n;
+    }
+    if (n >= 10) p[i++] = static_cast<char>('0' + n / 10);
+    p[i++] = static_cast<char>('0' + n % 10);
+    p[i++] = '\n';
+    longSalida += i;
+    tramasMap++;
+}
+
+/**
+ * Planifica y emite un bloque de texto sin saltos de línea
+ * 
+ * Programación dinámica exacta sobre los 27 desplazamientos: costo[q]
+ * es el mejor costo para haber emitido los caracteres anteriores
+ * terminando con el rotor en q. Antes de cada carga se puede rotar
+ * desde cualquier otro estado p (costo de la trama MAP de q - p); en
+ * las posiciones de MAP forzado la rotación es obligatoria.
+ * 
+ * La trama MAP solo tiene dos costos: avanzar 1..ROTACION_CORTA
+ * posiciones ("M,1".."M,9") y cualquier otro avance, un byte más. Así
+ * el mejor origen de q es el menor entre el mejor estado distinto de q
+ * (costo largo) y el mejor de la ventana q-9..q-1 (costo corto), que
+ * sale de mínimos por prefijo y sufijo. El resultado es el mismo que
+ * probar los 26 orígenes de cada q, con tres pasadas sobre 27 estados.
+ */
+void CodificadorPRT7::codificarBloque(const char* texto, std::size_t n) {
+    if (n == 0) return;
+    
+    // Caso rápido: sin MAPs forzados, minimizando tramas y con el rotor en 'A'
+    // (con desplazamiento 0 todo carácter se puede producir sin rotar)
+    if (objetivo == MINIMO_TRAMAS && cargasPorMap == 0 && desplazamiento == 0) {
+        reservar(n * 8);
+        for (std::size_t i = 0; i < n; i++) {
+            emitirCarga(texto[i]);
+        }
+        return;
+    }
+    
+    const long long mapCorto = static_cast<long long>(costoMap[1]) << 5;
+    const long long mapLargo = static_cast<long long>(costoMap[ROTACION_CORTA + 1]) << 5;
+    const long long SIN_CLAVE = static_cast<long long>(INFINITO) << 5 | TAM_ALFABETO;
+    
+    int costo[TAM_ALFABETO];
+    long long rotando[TAM_ALFABETO];  // Clave del mejor origen con la trama MAP sumada
+    long long clave[2 * TAM_ALFABETO];
+    long long prefijo[2 * TAM_ALFABETO];
+    long long sufijo[2 * TAM_ALFABETO];
+    for (int q = 0; q < TAM_ALFABETO; q++) costo[q] = INFINITO;
+    costo[desplazamiento] = 0;
+    
+    int contador = cargasDesdeMap;
+    
+    for (std::size_t i = 0; i < n; i++) {
+        int y = simboloPlano(texto[i]);
+        unsigned char* decision = origen + i * TAM_ALFABETO;
+        
+        if (y == -2) {
+            // '\r': no emite nada ni cambia el estado
+            memset(decision, SIN_ROTACION, TAM_ALFABETO);
+            continue;
+        }
+        
+        bool forzado = (cargasPorMap > 0 && contador >= cargasPorMap);
+        contador = forzado ? 1 : contador + 1;
+        
+        // Claves costo << 5 | estado: el mínimo entre claves trae su estado.
+        // Van duplicadas para leer de forma contigua la ventana circular
+        long long mejor = SIN_CLAVE;
+        long long segundo = SIN_CLAVE;
+        for (int p = 0; p < TAM_ALFABETO; p++) {
+            long long k = static_cast<long long>(costo[p]) << 5 | p;
+            clave[p] = k;
+            clave[p + TAM_ALFABETO] = k;
+            long long alto = (k < mejor) ? mejor : k;
+            mejor = (k < mejor) ? k : mejor;
+            segundo = (alto < segundo) ? alto : segundo;
+        }
+        
+        // Origen corto de q: el mejor de q-9..q-1 (índices q+18..q+26).
+        // Con mínimos por prefijo y sufijo en bloques de 9 (27 = 3 x 9)
+        // cada ventana es el sufijo de un bloque más el prefijo del siguiente
+        const int primero = TAM_ALFABETO - ROTACION_CORTA;
+        for (int b = primero; b < 2 * TAM_ALFABETO; b += ROTACION_CORTA) {
+            prefijo[b] = clave[b];
+            sufijo[b + ROTACION_CORTA - 1] = clave[b + ROTACION_CORTA - 1];
+            for (int k = 1; k < ROTACION_CORTA; k++) {
+                long long izq = clave[b + k];
+                long long der = clave[b + ROTACION_CORTA - 1 - k];
+                prefijo[b + k] = (izq < prefijo[b + k - 1]) ? izq : prefijo[b + k - 1];
+                sufijo[b + ROTACION_CORTA - 1 - k] = (der < sufijo[b + ROTACION_CORTA - k])
+                                                         ? der : sufijo[b + ROTACION_CORTA - k];
+            }
+        }
+        
+        // Sumar el costo de la trama a la clave conserva el estado en los
+        // bits bajos; los orígenes inalcanzables se saturan a INFINITO abajo
+        for (int q = 0; q < TAM_ALFABETO; q++) {
+            long long inicioVentana = sufijo[q + primero];
+            long long finVentana = prefijo[q + primero + ROTACION_CORTA - 1];
+            long long corto = ((inicioVentana < finVentana) ? inicioVentana : finVentana) + mapCorto;
+            long long largo = (((mejor & 31) == q) ? segundo : mejor) + mapLargo;
+            rotando[q] = (corto <= largo) ? corto : largo;
+        }
+        
+        const int* carga = costoCarga[y + 1];
+        const int tope = forzado ? 0 : INFINITO;
+        for (int q = 0; q < TAM_ALFABETO; q++) {
+            int sinRotar = (costo[q] < tope) ? costo[q] : INFINITO;
+            int costoRotando = static_cast<int>(rotando[q] >> 5);
+            bool rotar = costoRotando < sinRotar;
+            int total = (rotar ? costoRotando : sinRotar) + carga[q];
+            costo[q] = (total < INFINITO) ? total : INFINITO;
+            decision[q] = rotar ? static_cast<unsigned char>(rotando[q] & 31) : SIN_ROTACION;
+        }
+    }
+    
+    // Reconstruir la ruta desde el mejor estado final
+    int q = 0;
+    for (int p = 1; p < TAM_ALFABETO; p++) {
+        if (costo[p] < costo[q]) q = p;
+    }
+    
+    unsigned char* ruta = origen + BLOQUE * TAM_ALFABETO;
+    for (std::size_t i = n; i-- > 0; ) {
+        ruta[i] = static_cast<unsigned char>(q);
+        unsigned char d = origen[i * TAM_ALFABETO + q];
+        if (d != SIN_ROTACION) q = d;
+    }
+    
+    // Emitir: rotar cuando la ruta cambia o la decisión fue rotar
+    reservar(n * 8 + 64);
+    for (std::size_t i = 0; i < n; i++) {
+        if (simboloPlano(texto[i]) == -2) continue;
+        
+        int destino = ruta[i];
+        if (origen[i * TAM_ALFABETO + destino] != SIN_ROTACION) {
+            emitirMap(valorMap((destino - desplazamiento + TAM_ALFABETO) % TAM_ALFABETO));
+            desplazamiento = destino;
+        }
+        emitirCarga(texto[i]);
+    }
+    
+    cargasDesdeMap = contador;
+}
+
+/**
+ * Codifica texto: cada línea es una secuencia
+ */
+void CodificadorPRT7::codificar(const char* texto, std::size_t n) {
+    std::size_t inicio = 0;
+    
+    for (std::size_t i = 0; i <= n; i++) {
+        bool finLinea = (i < n && texto[i] == '\n');
+        bool finTexto = (i == n);
+        if (!finLinea && !finTexto && i - inicio < BLOQUE) continue;
+        
+        codificarBloque(texto + inicio, i - inicio);
+        
+        if (finLinea) {
+            agregarReinicio();
+            inicio = i + 1;
+        } else {
+            inicio = i;
+        }
+    }
+}
+
+/**
+ * Emite el marcador de reinicio y regresa el rotor del receptor a 'A'
+ */
+void CodificadorPRT7::agregarReinicio() {
+    static const char MARCADOR[] = "--- REINICIANDO SECUENCIA ---\n";
+    emitirTexto(MARCADOR, sizeof(MARCADOR) - 1);
+    desplazamiento = 0;
+    cargasDesdeMap = 0;
+}
+
+/**
+ * Obtiene las tramas generadas
+ */
+const char* CodificadorPRT7::obtenerSalida() const {
+    return salida;
+}
+
+/**
+ * Obtiene el número de bytes generados
+ */
+std::size_t CodificadorPRT7::obtenerLongitud() const {
+    return longSalida;
+}
+
+/**
+ * Descarta la salida ya consumida
+ */
+void CodificadorPRT7::limpiarSalida() {
+    longSalida = 0;
+}
+
+/**
+ * Obtiene el número de tramas LOAD emitidas
+ */
+unsigned long long CodificadorPRT7::obtenerTramasLoad() const {
+    return tramasLoad;
+}
+
+/**
+ * Obtiene el número de tramas MAP emitidas
+ */
+unsigned long long CodificadorPRT7::obtenerTramasMap() const {
+    return tramasMap;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file DecodificadorParalelo.cpp
+ * @brief Implementación de la decodificación de capturas en paralelo
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "DecodificadorParalelo.h"
+#include "PoolDeTrabajo.h"
+#include "BufferDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "Trazas.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Marcador de reinicio de secuencia (igual que BufferDeTramas)
+ */
+static const char MARCADOR[] = "REINICIANDO SECUENCIA";
+
+/**
+ * Verifica si un byte termina una línea (mismas reglas que BufferDeTramas)
+ */
+static bool esFinDeLinea(char c) {
+    return c == '\n' || c == '\r';
+}
+
+/**
+ * Constructor de DecodificadorParalelo
+ */
+DecodificadorParalelo::DecodificadorParalelo(int numHilos, int rotores)
+    : pool(nullptr), buffers(nullptr), numRotores(rotores < 1 ? 1 : rotores),
+      resultados(nullptr), numSecuencias(0) {
+    pool = new PoolDeTrabajo(numHilos);
+    
+    int n = pool->obtenerNumHilos();
+    buffers = new BufferDeTramas*[n];
+    for (int i = 0; i < n; i++) {
+        buffers[i] = new BufferDeTramas(1024, numRotores);
+    }
+}
+
+/**
+ * Destructor de DecodificadorParalelo
+ */
+DecodificadorParalelo::~DecodificadorParalelo() {
+    // Une los hilos antes de liberar lo que las tareas usan
+    int n = pool->obtenerNumHilos();
+    delete pool;
+    
+    for (int i = 0; i < n; i++) {
+        delete buffers[i];
+    }
+    delete[] buffers;
+    
+    for (int i = 0; i < numSecuencias; i++) {
+        delete[] resultados[i].mensaje;
+    }
+    delete[] resultados;
+}
+
+/**
+ * Divide la captura en secuencias
+ * 
+ * Cada línea que contiene el marcador cierra la secuencia anterior;
+ * la línea del marcador no pertenece a ninguna secuencia.
+ */
+void DecodificadorParalelo::dividir(const char* datos, std::size_t longitud) {
+    PRT7_TRAZA("DecodificadorParalelo::dividir");
+    
+    for (int i = 0; i < numSecuencias; i++) {
+        delete[] resultados[i].mensaje;
+    }
+    delete[] resultados;
+    resultados = nullptr;
+    numSecuencias = 0;
+    
+    int capacidad = 1024;
+    resultados = new ResultadoSecuencia[capacidad];
+    
+    const char* fin = datos + longitud;
+    const char* cursor = datos;
+    const std::size_t longMarcador = sizeof(MARCADOR) - 1;
+    
+    while (true) {
+        const char* marca = static_cast<const char*>(
+            memmem(cursor, static_cast<std::size_t>(fin - cursor), MARCADOR, longMarcador));
+        
+        // Límites de la secuencia actual y de la línea del marcador
+        const char* finSecuencia = fin;
+        const char* siguiente = fin;
+        if (marca != nullptr) {
+            finSecuencia = marca;
+            while (finSecuencia > cursor && !esFinDeLinea(finSecuencia[-1])) finSecuencia--;
+            siguiente = marca + longMarcador;
+            while (siguiente < fin && !esFinDeLinea(*siguiente)) siguiente++;
+            if (siguiente < fin) siguiente++;
+        }
+        
+        if (numSecuencias == capacidad) {
+            ResultadoSecuencia* nuevos = new ResultadoSecuencia[capacidad * 2];
+            memcpy(nuevos, resultados, capacidad * sizeof(ResultadoSecuencia));
+            delete[] resultados;
+            resultados = nuevos;
+            capacidad *= 2;
+        }
+        
+        ResultadoSecuencia& r = resultados[numSecuencias++];
+        r.inicio = cursor;
+        r.longitud = static_cast<std::size_t>(finSecuencia - cursor);
+        r.mensaje = nullptr;
+        r.longMensaje = 0;
+        r.errores = 0;
+        r.listo = false;
+        
+        if (marca == nullptr) break;
+        cursor = siguiente;
+    }
+}
+
+/**
+ * Tarea del pool: parsea y decodifica una secuencia con rotor (o cascada) y lista propios
+ */
+void DecodificadorParalelo::decodificarSecuencia(int indice, int hilo, void* contexto) {
+    DecodificadorParalelo* self = static_cast<DecodificadorParalelo*>(contexto);
+    ResultadoSecuencia& r = self->resultados[indice];
+    BufferDeTramas* tramas = self->buffers[hilo];
+    
+    tramas->limpiar();
+    tramas->parsearBloque(r.inicio, r.longitud);
+    tramas->finalizar();
+    
+    ListaDeCarga carga;
+    if (self->numRotores > 1) {
+        CascadaDeRotores cascada(self->numRotores);
+        tramas->ejecutar(&carga, &cascada);
+    } else {
+        RotorDeMapeo rotor;
+        tramas->ejecutar(&carga, &rotor);
+    }
+    
+    char* mensaje = nullptr;
+    std::size_t longMensaje = 0;
+    if (!carga.estaVacia()) {
+        std::size_t tamanio = static_cast<std::size_t>(carga.obtenerTamanio());
+        mensaje = new char[tamanio + 1];
+        longMensaje = carga.copiarA(mensaje, tamanio + 1);
+    }
+    
+    std::lock_guard<std::mutex> guardia(self->mutex);
+    r.mensaje = mensaje;
+    r.longMensaje = longMensaje;
+    r.errores = tramas->obtenerErrores();
+    r.listo = true;
+    self->terminada.notify_all();
+}
+
+/**
+ * Decodifica una captura en memoria y entrega las secuencias en orden
+ */
+int DecodificadorParalelo::decodificar(const char* datos, std::size_t longitud,
+                                       AlTerminarSecuencia fin, void* contexto) {
+    if (datos == nullptr) return 0;
+    
+    dividir(datos, longitud);
+    pool->lanzar(numSecuencias, decodificarSecuencia, this);
+    
+    // Entregar en orden: esperar a la siguiente secuencia pendiente
+    int errores = 0;
+    for (int i = 0; i < numSecuencias; i++) {
+        ResultadoSecuencia& r = resultados[i];
+        {
+            std::unique_lock<std::mutex> guardia(mutex);
+            while (!r.listo) {
+                terminada.wait(guardia);
+            }
+        }
+        
+        errores += r.errores;
+        if (r.mensaje != nullptr) {
+            if (fin != nullptr) {
+                fin(r.mensaje, r.longMensaje, contexto);
+            }
+            delete[] r.mensaje;
+            r.mensaje = nullptr;
+        }
+    }
+    
+    pool->esperar();
+    return errores;
+}
+
+/**
+ * Decodifica un archivo de captura mapeado en memoria
+ */
+int DecodificadorParalelo::decodificarArchivo(const char* ruta, AlTerminarSecuencia fin, void* contexto) {
+    int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    std::size_t longitud = static_cast<std::size_t>(info.st_size);
+    if (longitud == 0) {
+        close(fd);
+        numSecuencias = 0;
+        return 0;
+    }
+    
+    void* mapa = mmap(nullptr, longitud, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) return -1;
+    
+    // Lectura secuencial por tramos desde todos los hilos
+    madvise(mapa, longitud, MADV_WILLNEED);
+    
+    int errores = decodificar(static_cast<const char*>(mapa), longitud, fin, contexto);
+    
+    munmap(mapa, longitud);
+    return errores;
+}
+
+/**
+ * Obtiene el número de hilos trabajadores
+ */
+int DecodificadorParalelo::obtenerNumHilos() const {
+    return pool->obtenerNumHilos();
+}
+
+/**
+ * Obtiene el número de secuencias de la última captura
+ */
+int DecodificadorParalelo::obtenerNumSecuencias() const {
+    return numSecuencias;
+}
+
+/**
+ * Obtiene el número de tareas robadas entre hilos
+ */
+unsigned long long DecodificadorParalelo::obtenerRobos() const {
+    return pool->obtenerRobos();
+}
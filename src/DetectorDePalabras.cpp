@@ -0,0 +1,218 @@
+/**
+ * @file DetectorDePalabras.cpp
+ * @brief Implementación del autómata de Aho-Corasick
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "DetectorDePalabras.h"
+#include <cstring>
+
+/**
+ * Constructor de DetectorDePalabras
+ * Crea el estado inicial (raíz del trie)
+ */
+DetectorDePalabras::DetectorDePalabras(AlDetectar aviso, void* ctx)
+    : transiciones(nullptr), fallo(nullptr), patronEn(nullptr), enlaceSalida(nullptr),
+      numEstados(0), capEstados(0), idPatrones(nullptr), longPatrones(nullptr),
+      numPatrones(0), capPatrones(0), construido(false), estado(0), numSecuencia(1),
+      posicion(0), alDetectar(aviso), contexto(ctx) {
+    nuevoEstado();
+}
+
+/**
+ * Destructor de DetectorDePalabras
+ */
+DetectorDePalabras::~DetectorDePalabras() {
+    delete[] transiciones;
+    delete[] fallo;
+    delete[] patronEn;
+    delete[] enlaceSalida;
+    delete[] idPatrones;
+    delete[] longPatrones;
+}
+
+/**
+ * Convierte un carácter al índice de símbolo
+ */
+int DetectorDePalabras::simbolo(char c) {
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c == ' ') return 26;
+    return -1;
+}
+
+/**
+ * Crea un estado nuevo sin transiciones, duplicando los arreglos si es necesario
+ */
+int DetectorDePalabras::nuevoEstado() {
+    if (numEstados == capEstados) {
+        int nuevaCap = (capEstados == 0) ? 64 : capEstados * 2;
+        
+        int* t = new int[nuevaCap * TAM_ALFABETO];
+        int* f = new int[nuevaCap];
+        int* p = new int[nuevaCap];
+        int* e = new int[nuevaCap];
+        if (numEstados > 0) {
+            memcpy(t, transiciones, sizeof(int) * numEstados * TAM_ALFABETO);
+            memcpy(f, fallo, sizeof(int) * numEstados);
+            memcpy(p, patronEn, sizeof(int) * numEstados);
+            memcpy(e, enlaceSalida, sizeof(int) * numEstados);
+        }
+        delete[] transiciones;
+        delete[] fallo;
+        delete[] patronEn;
+        delete[] enlaceSalida;
+        transiciones = t;
+        fallo = f;
+        patronEn = p;
+        enlaceSalida = e;
+        capEstados = nuevaCap;
+    }
+    
+    int nuevo = numEstados++;
+    for (int s = 0; s < TAM_ALFABETO; s++) {
+        transiciones[nuevo * TAM_ALFABETO + s] = -1;
+    }
+    fallo[nuevo] = 0;
+    patronEn[nuevo] = -1;
+    enlaceSalida[nuevo] = -1;
+    return nuevo;
+}
+
+/**
+ * Agrega una palabra al trie
+ */
+bool DetectorDePalabras::agregarPatron(const char* palabra, int id) {
+    if (construido || palabra == nullptr || palabra[0] == '\0') return false;
+    
+    for (const char* p = palabra; *p; p++) {
+        if (simbolo(*p) < 0) return false;
+    }
+    
+    if (numPatrones == capPatrones) {
+        int nuevaCap = (capPatrones == 0) ? 8 : capPatrones * 2;
+        int* ids = new int[nuevaCap];
+        int* longs = new int[nuevaCap];
+        if (numPatrones > 0) {
+            memcpy(ids, idPatrones, sizeof(int) * numPatrones);
+            memcpy(longs, longPatrones, sizeof(int) * numPatrones);
+        }
+        delete[] idPatrones;
+        delete[] longPatrones;
+        idPatrones = ids;
+        longPatrones = longs;
+        capPatrones = nuevaCap;
+    }
+    
+    int actual = 0;
+    int longitud = 0;
+    for (const char* p = palabra; *p; p++) {
+        int s = simbolo(*p);
+        if (transiciones[actual * TAM_ALFABETO + s] < 0) {
+            int nuevo = nuevoEstado();
+            transiciones[actual * TAM_ALFABETO + s] = nuevo;
+        }
+        actual = transiciones[actual * TAM_ALFABETO + s];
+        longitud++;
+    }
+    
+    // Palabra repetida: se conserva el primer id
+    if (patronEn[actual] < 0) {
+        patronEn[actual] = numPatrones;
+        idPatrones[numPatrones] = id;
+        longPatrones[numPatrones] = longitud;
+        numPatrones++;
+    }
+    
+    return true;
+}
+
+/**
+ * Recorre el trie por niveles (BFS) para calcular fallos, enlaces de
+ * salida y la tabla completa de transiciones
+ */
+void DetectorDePalabras::construir() {
+    if (construido) return;
+    
+    // Cola BFS manual sobre un arreglo (cada estado entra una sola vez)
+    int* cola = new int[numEstados];
+    int inicio = 0;
+    int fin = 0;
+    
+    for (int s = 0; s < TAM_ALFABETO; s++) {
+        int hijo = transiciones[s];
+        if (hijo < 0) {
+            transiciones[s] = 0;
+        } else {
+            fallo[hijo] = 0;
+            cola[fin++] = hijo;
+        }
+    }
+    
+    while (inicio < fin) {
+        int u = cola[inicio++];
+        
+        // El enlace de salida apunta al sufijo más largo que es un patrón
+        int f = fallo[u];
+        enlaceSalida[u] = (patronEn[f] >= 0) ? f : enlaceSalida[f];
+        
+        for (int s = 0; s < TAM_ALFABETO; s++) {
+            int hijo = transiciones[u * TAM_ALFABETO + s];
+            if (hijo < 0) {
+                transiciones[u * TAM_ALFABETO + s] = transiciones[f * TAM_ALFABETO + s];
+            } else {
+                fallo[hijo] = transiciones[f * TAM_ALFABETO + s];
+                cola[fin++] = hijo;
+            }
+        }
+    }
+    
+    delete[] cola;
+    construido = true;
+}
+
+/**
+ * Avanza un estado y avisa las coincidencias que terminan aquí
+ */
+void DetectorDePalabras::avanzar(char c) {
+    if (!construido) construir();
+    
+    int s = simbolo(c);
+    if (s < 0) {
+        estado = 0;
+        posicion++;
+        return;
+    }
+    
+    estado = transiciones[estado * TAM_ALFABETO + s];
+    
+    // Recorrer solo los estados con patrón (costo proporcional a las coincidencias)
+    int e = (patronEn[estado] >= 0) ? estado : enlaceSalida[estado];
+    while (e >= 0) {
+        int p = patronEn[e];
+        if (alDetectar != nullptr) {
+            alDetectar(idPatrones[p], numSecuencia, posicion - longPatrones[p] + 1, contexto);
+        }
+        e = enlaceSalida[e];
+    }
+    
+    posicion++;
+}
+
+/**
+ * Comienza una nueva secuencia
+ */
+void DetectorDePalabras::reiniciarSecuencia() {
+    if (posicion > 0) numSecuencia++;
+    estado = 0;
+    posicion = 0;
+}
+
+/**
+ * Obtiene el número de patrones
+ */
+int DetectorDePalabras::obtenerNumPatrones() const {
+    return numPatrones;
+}
@@ -0,0 +1,498 @@
+/**
+ * @file EscritorAsincrono.cpp
+ * @brief Implementación del escritor asíncrono multi-destino
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "EscritorAsincrono.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * Máximo de mensajes agrupados en una sola llamada a writev
+ */
+static const int MAX_IOV = 64;
+
+/**
+ * Tiempo actual del reloj monotónico en nanosegundos
+ */
+static unsigned long long ahoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Reabre una terminal o tubería ajena con su propia descripción no bloqueante
+ * 
+ * Solo terminales y FIFOs: un archivo regular reabierto empezaría en otro
+ * desplazamiento (y nunca devuelve EAGAIN), y un socket no se puede reabrir.
+ */
+static int reabrirNoBloqueante(int fd) {
+    struct stat info;
+    if (fstat(fd, &info) != 0) return -1;
+    if (!S_ISCHR(info.st_mode) && !S_ISFIFO(info.st_mode)) return -1;
+    
+    char ruta[64];
+    snprintf(ruta, sizeof(ruta), "/proc/self/fd/%d", fd);
+    return open(ruta, O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+}
+
+/**
+ * Constructor de EscritorAsincrono
+ */
+EscritorAsincrono::EscritorAsincrono() : numDestinos(0), enMarcha(false), deteniendo(false),
+                                         abortando(false) {
+    memset(destinos, 0, sizeof(destinos));
+    tuberiaDespertar[0] = -1;
+    tuberiaDespertar[1] = -1;
+}
+
+/**
+ * Destructor de EscritorAsincrono
+ */
+EscritorAsincrono::~EscritorAsincrono() {
+    detener();
+    
+    for (int i = 0; i < numDestinos; i++) {
+        vaciarDestino(destinos[i]);
+        if (destinos[i].propio) {
+            close(destinos[i].fd);
+        }
+    }
+    numDestinos = 0;
+}
+
+/**
+ * Registra un descriptor como destino
+ */
+int EscritorAsincrono::agregarDescriptor(int fd, Politica politica, std::size_t limiteBytes, bool propio) {
+    if (fd < 0 || enMarcha || numDestinos >= MAX_DESTINOS) return -1;
+    
+    // No bloqueante: el hilo escritor espera con poll() y nunca se queda
+    // atorado en un solo destino. O_NONBLOCK vive en la descripción de
+    // archivo abierta, que un descriptor ajeno (p. ej. stdout) comparte con
+    // stdin y stderr de la terminal: en ese caso se reabre por /proc para
+    // tener una descripción propia, o se escribe bloqueando si no se puede
+    if (propio) {
+        int banderas = fcntl(fd, F_GETFL, 0);
+        if (banderas >= 0) {
+            fcntl(fd, F_SETFL, banderas | O_NONBLOCK);
+        }
+    } else {
+        int reabierto = reabrirNoBloqueante(fd);
+        if (reabierto >= 0) {
+            fd = reabierto;
+            propio = true;
+        }
+    }
+    
+    Destino& d = destinos[numDestinos];
+    memset(&d, 0, sizeof(d));
+    d.fd = fd;
+    d.propio = propio;
+    d.politica = politica;
+    d.limiteBytes = limiteBytes;
+    
+    return numDestinos++;
+}
+
+/**
+ * Abre un archivo en modo append como destino
+ */
+int EscritorAsincrono::agregarArchivo(const char* ruta, Politica politica, std::size_t limiteBytes) {
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return -1;
+    
+    int indice = agregarDescriptor(fd, politica, limiteBytes, true);
+    if (indice < 0) close(fd);
+    return indice;
+}
+
+/**
+ * Conecta a un socket UNIX como destino
+ */
+int EscritorAsincrono::agregarSocketUnix(const char* ruta, Politica politica, std::size_t limiteBytes) {
+    struct sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (strlen(ruta) >= sizeof(direccion.sun_path)) return -1;
+    strcpy(direccion.sun_path, ruta);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&direccion), sizeof(direccion)) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    // Un consumidor desconectado no debe terminar el proceso
+    signal(SIGPIPE, SIG_IGN);
+    
+    int indice = agregarDescriptor(fd, politica, limiteBytes, true);
+    if (indice < 0) close(fd);
+    return indice;
+}
+
+/**
+ * Arranca el hilo escritor
+ */
+bool EscritorAsincrono::iniciar() {
+    if (enMarcha) return true;
+    
+    if (pipe(tuberiaDespertar) != 0) return false;
+    fcntl(tuberiaDespertar[0], F_SETFL, O_NONBLOCK);
+    fcntl(tuberiaDespertar[1], F_SETFL, O_NONBLOCK);
+    
+    deteniendo = false;
+    abortando = false;
+    enMarcha = true;
+    hilo = std::thread(&EscritorAsincrono::bucleEscritor, this);
+    return true;
+}
+
+/**
+ * Escribe lo pendiente y detiene el hilo
+ */
+void EscritorAsincrono::detener(int esperaMaxMs) {
+    if (!enMarcha) return;
+    
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        deteniendo = true;
+    }
+    espacioLibre.notify_all();
+    
+    // Esperar a que se vacíen las colas (o a que venza el plazo)
+    unsigned long long limite = ahoraNs() + static_cast<unsigned long long>(esperaMaxMs) * 1000000ULL;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> guardia(mutex);
+            if (colasVacias()) break;
+        }
+        if (ahoraNs() >= limite) break;
+        despertar();
+        usleep(1000);
+    }
+    
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        abortando = true;
+    }
+    despertar();
+    hilo.join();
+    
+    // El hilo ya terminó: nadie más usa los mensajes pendientes
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        for (int i = 0; i < numDestinos; i++) {
+            vaciarDestino(destinos[i]);
+        }
+    }
+    
+    close(tuberiaDespertar[0]);
+    close(tuberiaDespertar[1]);
+    tuberiaDespertar[0] = -1;
+    tuberiaDespertar[1] = -1;
+    enMarcha = false;
+}
+
+/**
+ * Despierta al hilo escritor (self-pipe)
+ */
+void EscritorAsincrono::despertar() {
+    if (tuberiaDespertar[1] < 0) return;
+    char c = 1;
+    ssize_t r = write(tuberiaDespertar[1], &c, 1);
+    (void)r;  // Si la tubería está llena el hilo ya tiene un aviso pendiente
+}
+
+/**
+ * Verifica si todas las colas están vacías (llamar con el mutex tomado)
+ */
+bool EscritorAsincrono::colasVacias() const {
+    for (int i = 0; i < numDestinos; i++) {
+        if (destinos[i].cabeza != nullptr) return false;
+    }
+    return true;
+}
+
+/**
+ * Libera un nodo de la cola y su mensaje si ya nadie lo referencia
+ * (llamar con el mutex tomado)
+ */
+void EscritorAsincrono::liberarNodo(Destino& d, NodoSalida* nodo, bool escrito) {
+    MensajeSalida* m = nodo->mensaje;
+    
+    if (escrito) {
+        unsigned long long latencia = ahoraNs() - m->encoladoNs;
+        d.estadisticas.mensajesEscritos++;
+        d.estadisticas.latenciaTotalNs += latencia;
+        if (latencia > d.estadisticas.latenciaMaxNs) {
+            d.estadisticas.latenciaMaxNs = latencia;
+        }
+    }
+    
+    d.bytesPendientes -= (m->longitud - d.desplazamiento);
+    d.desplazamiento = 0;
+    
+    if (--m->referencias == 0) {
+        delete[] m->datos;
+        delete m;
+    }
+    delete nodo;
+}
+
+/**
+ * Descarta toda la cola de un destino (llamar con el mutex tomado)
+ */
+void EscritorAsincrono::vaciarDestino(Destino& d) {
+    while (d.cabeza != nullptr) {
+        NodoSalida* siguiente = d.cabeza->siguiente;
+        liberarNodo(d, d.cabeza, false);
+        d.cabeza = siguiente;
+    }
+    d.cola = nullptr;
+    d.bytesPendientes = 0;
+}
+
+/**
+ * Encola un bloque de texto para todos los destinos
+ */
+void EscritorAsincrono::escribir(const char* datos, std::size_t longitud) {
+    if (datos == nullptr || longitud == 0) return;
+    
+    MensajeSalida* m = new MensajeSalida;
+    m->datos = new char[longitud];
+    memcpy(m->datos, datos, longitud);
+    m->longitud = longitud;
+    m->referencias = 1;  // Referencia propia mientras se reparte a los destinos
+    m->encoladoNs = ahoraNs();
+    
+    std::unique_lock<std::mutex> candado(mutex);
+    
+    for (int i = 0; i < numDestinos; i++) {
+        Destino& d = destinos[i];
+        if (d.estadisticas.error) continue;
+        
+        if (d.bytesPendientes > 0 && d.bytesPendientes + longitud > d.limiteBytes) {
+            if (d.politica == DESCARTAR || !enMarcha) {
+                d.estadisticas.mensajesDescartados++;
+                d.estadisticas.bytesDescartados += longitud;
+                continue;
+            }
+            
+            // BLOQUEAR: esperar a que el hilo escritor libere espacio
+            while (d.bytesPendientes > 0 && d.bytesPendientes + longitud > d.limiteBytes &&
+                   !d.estadisticas.error && !deteniendo) {
+                espacioLibre.wait(candado);
+            }
+            if (d.estadisticas.error) continue;
+        }
+        
+        NodoSalida* nodo = new NodoSalida(m);
+        if (d.cola == nullptr) {
+            d.cabeza = nodo;
+        } else {
+            d.cola->siguiente = nodo;
+        }
+        d.cola = nodo;
+        d.bytesPendientes += longitud;
+        m->referencias++;
+    }
+    
+    if (--m->referencias == 0) {
+        delete[] m->datos;
+        delete m;
+    }
+    
+    candado.unlock();
+    despertar();
+}
+
+/**
+ * Escribe con una sola llamada a writev los mensajes pendientes de un destino
+ */
+void EscritorAsincrono::escribirLote(int indice) {
+    Destino& d = destinos[indice];
+    struct iovec iov[MAX_IOV];
+    int numIov = 0;
+    
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        NodoSalida* nodo = d.cabeza;
+        std::size_t desplazamiento = d.desplazamiento;
+        while (nodo != nullptr && numIov < MAX_IOV) {
+            iov[numIov].iov_base = nodo->mensaje->datos + desplazamiento;
+            iov[numIov].iov_len = nodo->mensaje->longitud - desplazamiento;
+            numIov++;
+            desplazamiento = 0;
+            nodo = nodo->siguiente;
+        }
+    }
+    
+    if (numIov == 0) return;
+    
+    // Los mensajes no se liberan fuera de este hilo, así que el iovec
+    // sigue siendo válido sin el mutex. Un destino bloqueante puede
+    // detener aquí al hilo hasta que su lector avance
+    ssize_t escritos = writev(d.fd, iov, numIov);
+    
+    std::lock_guard<std::mutex> guardia(mutex);
+    
+    if (escritos < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+        d.estadisticas.error = true;
+        vaciarDestino(d);
+        espacioLibre.notify_all();
+        return;
+    }
+    
+    d.estadisticas.llamadasWritev++;
+    d.estadisticas.bytesEscritos += static_cast<unsigned long long>(escritos);
+    
+    std::size_t restante = static_cast<std::size_t>(escritos);
+    while (d.cabeza != nullptr) {
+        std::size_t faltante = d.cabeza->mensaje->longitud - d.desplazamiento;
+        if (restante < faltante) {
+            // Escritura parcial: continuar desde aquí en el próximo lote
+            d.desplazamiento += restante;
+            d.bytesPendientes -= restante;
+            break;
+        }
+        
+        restante -= faltante;
+        NodoSalida* siguiente = d.cabeza->siguiente;
+        liberarNodo(d, d.cabeza, true);
+        d.cabeza = siguiente;
+        if (d.cabeza == nullptr) d.cola = nullptr;
+    }
+    
+    espacioLibre.notify_all();
+}
+
+/**
+ * Bucle del hilo escritor: espera con poll() a que haya datos y destinos listos
+ */
+void EscritorAsincrono::bucleEscritor() {
+    struct pollfd fds[MAX_DESTINOS + 1];
+    int indiceDe[MAX_DESTINOS + 1];
+    
+    while (true) {
+        int numFds = 0;
+        fds[numFds].fd = tuberiaDespertar[0];
+        fds[numFds].events = POLLIN;
+        fds[numFds].revents = 0;
+        indiceDe[numFds] = -1;
+        numFds++;
+        
+        {
+            std::lock_guard<std::mutex> guardia(mutex);
+            if (deteniendo && (abortando || colasVacias())) break;
+            
+            for (int i = 0; i < numDestinos; i++) {
+                if (destinos[i].cabeza != nullptr && !destinos[i].estadisticas.error) {
+                    fds[numFds].fd = destinos[i].fd;
+                    fds[numFds].events = POLLOUT;
+                    fds[numFds].revents = 0;
+                    indiceDe[numFds] = i;
+                    numFds++;
+                }
+            }
+        }
+        
+        if (poll(fds, numFds, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            char basura[256];
+            while (read(tuberiaDespertar[0], basura, sizeof(basura)) > 0) {
+            }
+        }
+        
+        for (int k = 1; k < numFds; k++) {
+            if (fds[k].revents & (POLLOUT | POLLERR | POLLHUP)) {
+                escribirLote(indiceDe[k]);
+            }
+        }
+    }
+}
+
+/**
+ * Obtiene una copia de los contadores de un destino
+ */
+EstadisticasDestino EscritorAsincrono::obtenerEstadisticas(int indice) {
+    EstadisticasDestino vacio;
+    memset(&vacio, 0, sizeof(vacio));
+    if (indice < 0 || indice >= numDestinos) return vacio;
+    
+    std::lock_guard<std::mutex> guardia(mutex);
+    return destinos[indice].estadisticas;
+}
+
+/**
+ * Obtiene el número de destinos registrados
+ */
+int EscritorAsincrono::obtenerNumDestinos() const {
+    return numDestinos;
+}
+
+/**
+ * Constructor de FlujoAsincrono
+ */
+FlujoAsincrono::FlujoAsincrono(EscritorAsincrono* e) : escritor(e) {
+    setp(buffer, buffer + TAM_BUFFER);
+}
+
+/**
+ * Destructor de FlujoAsincrono
+ */
+FlujoAsincrono::~FlujoAsincrono() {
+    enviar();
+}
+
+/**
+ * Encola el contenido del buffer como un mensaje
+ */
+void FlujoAsincrono::enviar() {
+    std::ptrdiff_t longitud = pptr() - pbase();
+    if (longitud > 0 && escritor != nullptr) {
+        escritor->escribir(pbase(), static_cast<std::size_t>(longitud));
+    }
+    setp(buffer, buffer + TAM_BUFFER);
+}
+
+/**
+ * Buffer lleno: enviar y guardar el carácter pendiente
+ */
+FlujoAsincrono::int_type FlujoAsincrono::overflow(int_type c) {
+    enviar();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+/**
+ * flush / std::endl: enviar lo acumulado
+ */
+int FlujoAsincrono::sync() {
+    enviar();
+    return 0;
+}
@@ -7,12 +7,74 @@
  */
 
 #include "ListaDeCarga.h"
+#include "DetectorDePalabras.h"
+#include "VentanaDeCarga.h"
+#include "MensajeEmpaquetado.h"
+#include "Trazas.h"
 #include <iostream>
 
+/**
+ * Imprime el contenido de la ventana (lo derramado a disco solo se resume)
+ */
+static void imprimirVentana(const VentanaDeCarga* ventana, bool corchetes) {
+    std::size_t anteriores = ventana->obtenerTamanio() - ventana->obtenerEnMemoria();
+    if (anteriores > 0) {
+        std::cout << "[... " << anteriores << " caracteres anteriores fuera de memoria ...]";
+    }
+    
+    const std::size_t TAM = 4096;
+    char tramo[TAM];
+    std::size_t posicion = anteriores;
+    std::size_t fin = ventana->obtenerTamanio();
+    while (posicion < fin) {
+        std::size_t n = ventana->leer(posicion, tramo, TAM);
+        if (n == 0) break;
+        if (corchetes) {
+            for (std::size_t i = 0; i < n; i++) {
+                std::cout << "[" << tramo[i] << "]";
+            }
+        } else {
+            std::cout.write(tramo, static_cast<std::streamsize>(n));
+        }
+        posicion += n;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Copia la secuencia de la ventana: lo derramado al segmento y después
+ * el anillo (el tramo que se perdió al derramar no se puede leer)
+ */
+static std::size_t copiarSecuencia(const VentanaDeCarga* ventana, char* buffer, std::size_t capacidad) {
+    std::size_t tamanio = ventana->obtenerTamanio();
+    std::size_t tramos[2][2] = {
+        { 0, ventana->obtenerEnDisco() },
+        { tamanio - ventana->obtenerEnMemoria(), tamanio }
+    };
+    
+    std::size_t escritos = 0;
+    for (int t = 0; t < 2; t++) {
+        std::size_t posicion = tramos[t][0];
+        while (posicion < tramos[t][1] && escritos < capacidad - 1) {
+            std::size_t n = tramos[t][1] - posicion;
+            if (n > capacidad - 1 - escritos) n = capacidad - 1 - escritos;
+            std::size_t leidos = ventana->leer(posicion, buffer + escritos, n);
+            if (leidos == 0) break;  // El segmento no se pudo mapear
+            escritos += leidos;
+            posicion += leidos;
+        }
+    }
+    
+    buffer[escritos] = '\0';
+    return escritos;
+}
+
 /**
  * Constructor de ListaDeCarga
  */
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
+ListaDeCarga::ListaDeCarga()
+    : cabeza(nullptr), cola(nullptr), tamanio(0), detector(nullptr), ventana(nullptr),
+      empaquetado(nullptr) {
 }
 
 /**
@@ -20,21 +82,33 @@ ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
  * Libera toda la memoria de los nodos
  */
 ListaDeCarga::~ListaDeCarga() {
-    NodoCarga* actual = cabeza;
-    while (actual != nullptr) {
-        NodoCarga* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    }
-    cabeza = nullptr;
-    cola = nullptr;
-    tamanio = 0;
+    liberarNodos();
 }
 
 /**
  * Inserta un carácter al final de la lista
  */
 void ListaDeCarga::insertarAlFinal(char codificado, char decodificado) {
+    PRT7_TRAZA("ListaDeCarga::insertarAlFinal");
+    
+    // Modo ventana: sin nodos, memoria fija
+    if (ventana != nullptr) {
+        ventana->agregar(decodificado);
+        if (detector != nullptr) {
+            detector->avanzar(decodificado);
+        }
+        return;
+    }
+    
+    // Modo empaquetado: sin nodos, 5 bits por símbolo
+    if (empaquetado != nullptr) {
+        empaquetado->agregar(codificado, decodificado);
+        if (detector != nullptr) {
+            detector->avanzar(decodificado);
+        }
+        return;
+    }
+    
     NodoCarga* nuevoNodo = new NodoCarga(codificado, decodificado);
     
     if (estaVacia()) {
@@ -49,17 +123,33 @@ void ListaDeCarga::insertarAlFinal(char codificado, char decodificado) {
     }
     
     tamanio++;
+    
+    if (detector != nullptr) {
+        detector->avanzar(decodificado);
+    }
 }
 
 /**
  * Imprime el mensaje completo decodificado
  */
 void ListaDeCarga::imprimirMensaje() const {
+    PRT7_TRAZA("ListaDeCarga::imprimirMensaje");
+    
     if (estaVacia()) {
         std::cout << "[MENSAJE VACIO]" << std::endl;
         return;
     }
     
+    if (ventana != nullptr) {
+        imprimirVentana(ventana, false);
+        return;
+    }
+    
+    if (empaquetado != nullptr) {
+        empaquetado->imprimirMensaje();
+        return;
+    }
+    
     // Mostrar solo el mensaje decodificado
     NodoCarga* actual = cabeza;
     while (actual != nullptr) {
@@ -74,8 +164,20 @@ void ListaDeCarga::imprimirMensaje() const {
  * Muestra los caracteres DECODIFICADOS (después del mapeo del rotor)
  */
 void ListaDeCarga::imprimirMensajeParcial() const {
+    PRT7_TRAZA("ListaDeCarga::imprimirMensajeParcial");
+    
     std::cout << "Mensaje: ";
     
+    if (ventana != nullptr) {
+        imprimirVentana(ventana, true);
+        return;
+    }
+    
+    if (empaquetado != nullptr) {
+        empaquetado->imprimirMensajeParcial();
+        return;
+    }
+    
     NodoCarga* actual = cabeza;
     while (actual != nullptr) {
         std::cout << "[" << actual->datoDecodificado << "]";
@@ -89,6 +191,12 @@ void ListaDeCarga::imprimirMensajeParcial() const {
  * Obtiene el tamaño de la lista
  */
 int ListaDeCarga::obtenerTamanio() const {
+    if (ventana != nullptr) {
+        return static_cast<int>(ventana->obtenerTamanio());
+    }
+    if (empaquetado != nullptr) {
+        return static_cast<int>(empaquetado->obtenerTamanio());
+    }
     return tamanio;
 }
 
@@ -96,5 +204,133 @@ int ListaDeCarga::obtenerTamanio() const {
  * Verifica si la lista está vacía
  */
 bool ListaDeCarga::estaVacia() const {
+    if (ventana != nullptr) {
+        return ventana->obtenerTamanio() == 0;
+    }
+    if (empaquetado != nullptr) {
+        return empaquetado->obtenerTamanio() == 0;
+    }
     return cabeza == nullptr;
 }
+
+/**
+ * Elimina todos los nodos de la lista y avisa al detector
+ */
+void ListaDeCarga::vaciar() {
+    liberarNodos();
+    
+    if (ventana != nullptr) {
+        ventana->vaciar();
+    }
+    
+    if (empaquetado != nullptr) {
+        empaquetado->vaciar();
+    }
+    
+    if (detector != nullptr) {
+        detector->reiniciarSecuencia();
+    }
+}
+
+/**
+ * Asocia un detector de palabras
+ */
+void ListaDeCarga::setDetector(DetectorDePalabras* d) {
+    detector = d;
+}
+
+/**
+ * Activa o desactiva el modo ventana
+ */
+void ListaDeCarga::setVentana(VentanaDeCarga* v) {
+    ventana = v;
+}
+
+/**
+ * Activa o desactiva el modo empaquetado
+ */
+void ListaDeCarga::setEmpaquetado(MensajeEmpaquetado* m) {
+    empaquetado = m;
+}
+
+/**
+ * Obtiene cuántos caracteres exporta copiarA con un buffer suficiente
+ */
+std::size_t ListaDeCarga::obtenerCopiables(Campo campo) const {
+    if (ventana != nullptr) {
+        // El prefijo en disco y el anillo; el tramo perdido al derramar no
+        if (campo == CODIFICADO) return 0;
+        return ventana->obtenerEnDisco() + ventana->obtenerEnMemoria();
+    }
+    return static_cast<std::size_t>(obtenerTamanio());
+}
+
+/**
+ * Lee un carácter de lo que exporta copiarA sin nodos: en la ventana el
+ * índice salta el tramo perdido al derramar
+ */
+char ListaDeCarga::leerCaracter(std::size_t posicion, Campo campo) const {
+    char c = '\0';
+    if (ventana != nullptr) {
+        std::size_t enDisco = ventana->obtenerEnDisco();
+        if (posicion >= enDisco) {
+            posicion += ventana->obtenerTamanio() - ventana->obtenerEnMemoria() - enDisco;
+        }
+        ventana->leer(posicion, &c, 1);
+    } else if (empaquetado != nullptr) {
+        c = empaquetado->leer(posicion, campo);
+    }
+    return c;
+}
+
+/**
+ * Verifica si el mensaje está en nodos (los iteradores los siguen)
+ */
+bool ListaDeCarga::tieneNodos() const {
+    return ventana == nullptr && empaquetado == nullptr;
+}
+
+/**
+ * Libera todos los nodos
+ */
+void ListaDeCarga::liberarNodos() {
+    NodoCarga* actual = cabeza;
+    while (actual != nullptr) {
+        NodoCarga* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+    cabeza = nullptr;
+    cola = nullptr;
+    tamanio = 0;
+}
+
+/**
+ * Copia el mensaje (codificado o decodificado) a un buffer C-style
+ */
+std::size_t ListaDeCarga::copiarA(char* buffer, std::size_t capacidad, Campo campo) const {
+    if (buffer == nullptr || capacidad == 0) return 0;
+    
+    if (ventana != nullptr) {
+        if (campo == CODIFICADO) {
+            buffer[0] = '\0';
+            return 0;  // La ventana no guarda el campo codificado
+        }
+        return copiarSecuencia(ventana, buffer, capacidad);
+    }
+    
+    if (empaquetado != nullptr) {
+        return empaquetado->copiarA(buffer, capacidad, campo);
+    }
+    
+    std::size_t escritos = 0;
+    NodoCarga* actual = cabeza;
+    while (actual != nullptr && escritos < capacidad - 1) {
+        buffer[escritos++] = (campo == CODIFICADO) ? actual->datoCodificado
+                                                   : actual->datoDecodificado;
+        actual = actual->siguiente;
+    }
+    buffer[escritos] = '\0';
+    
+    return escritos;
+}
@@ -0,0 +1,388 @@
+/**
+ * @file MensajeEmpaquetado.cpp
+ * @brief Implementación del mensaje empaquetado a 5 bits por símbolo
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "MensajeEmpaquetado.h"
+#include <iostream>
+#include <cstring>
+
+/**
+ * Carácter de cada símbolo de 5 bits (27 del alfabeto, el resto no se usa)
+ */
+static const char CARACTER_DE[33] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ?????";
+
+/**
+ * Símbolo de 5 bits de un carácter (ESCAPE si está fuera del alfabeto)
+ * Con plegar las minúsculas pasan a mayúsculas, igual que en
+ * RotorDeMapeo::getMapeo; sin plegar son excepciones
+ */
+static inline unsigned long long simboloDe(char c, bool plegar) {
+    if (c >= 'A' && c <= 'Z') return static_cast<unsigned long long>(c - 'A');
+    if (plegar && c >= 'a' && c <= 'z') return static_cast<unsigned long long>(c - 'a');
+    if (c == ' ') return 26;
+    return MensajeEmpaquetado::ESCAPE;
+}
+
+/**
+ * Constructor de MensajeEmpaquetado
+ */
+MensajeEmpaquetado::MensajeEmpaquetado() : tamanio(0) {
+    memset(flujos, 0, sizeof(flujos));
+}
+
+/**
+ * Destructor de MensajeEmpaquetado
+ */
+MensajeEmpaquetado::~MensajeEmpaquetado() {
+    for (int i = 0; i < 2; i++) {
+        delete[] flujos[i].palabras;
+        delete[] flujos[i].posExcepciones;
+        delete[] flujos[i].valExcepciones;
+    }
+}
+
+/**
+ * Asegura espacio para al menos 'palabras' palabras
+ */
+void MensajeEmpaquetado::reservarPalabras(FlujoEmpaquetado& f, std::size_t palabras) {
+    if (palabras <= f.capPalabras) return;
+    
+    std::size_t nuevaCap = (f.capPalabras == 0) ? 4 : f.capPalabras * 2;
+    while (nuevaCap < palabras) nuevaCap *= 2;
+    
+    unsigned long long* nuevas = new unsigned long long[nuevaCap];
+    if (f.capPalabras > 0) {
+        memcpy(nuevas, f.palabras, f.capPalabras * sizeof(unsigned long long));
+    }
+    delete[] f.palabras;
+    f.palabras = nuevas;
+    f.capPalabras = nuevaCap;
+}
+
+/**
+ * Guarda un carácter fuera del alfabeto sin comprimir
+ */
+void MensajeEmpaquetado::agregarExcepcion(FlujoEmpaquetado& f, std::size_t posicion, char valor) {
+    if (f.numExcepciones == f.capExcepciones) {
+        std::size_t nuevaCap = (f.capExcepciones == 0) ? 4 : f.capExcepciones * 2;
+        std::size_t* pos = new std::size_t[nuevaCap];
+        char* val = new char[nuevaCap];
+        if (f.numExcepciones > 0) {
+            memcpy(pos, f.posExcepciones, f.numExcepciones * sizeof(std::size_t));
+            memcpy(val, f.valExcepciones, f.numExcepciones);
+        }
+        delete[] f.posExcepciones;
+        delete[] f.valExcepciones;
+        f.posExcepciones = pos;
+        f.valExcepciones = val;
+        f.capExcepciones = nuevaCap;
+    }
+    
+    f.posExcepciones[f.numExcepciones] = posicion;
+    f.valExcepciones[f.numExcepciones] = valor;
+    f.numExcepciones++;
+}
+
+/**
+ * Agrega n caracteres a un campo a partir de la posición 'tamanio'
+ * Solo el campo decodificado pliega minúsculas: el codificado guarda
+ * lo recibido tal cual
+ */
+void MensajeEmpaquetado::agregarCampo(ListaDeCarga::Campo campo, const char* texto, std::size_t n) {
+    FlujoEmpaquetado& f = flujos[campo];
+    bool plegar = (campo == ListaDeCarga::DECODIFICADO);
+    std::size_t pos = tamanio;
+    std::size_t i = 0;
+    reservarPalabras(f, (pos + n + SIMBOLOS_POR_PALABRA - 1) / SIMBOLOS_POR_PALABRA);
+    
+    // Completar la palabra parcial uno por uno
+    while (i < n && pos % SIMBOLOS_POR_PALABRA != 0) {
+        unsigned long long s = simboloDe(texto[i], plegar);
+        f.palabras[pos / SIMBOLOS_POR_PALABRA] |= s << ((pos % SIMBOLOS_POR_PALABRA) * 5);
+        if (s == ESCAPE) agregarExcepcion(f, pos, texto[i]);
+        i++;
+        pos++;
+    }
+    
+    // El resto, alineado a palabra, con el núcleo por bloques
+    if (i < n) {
+        std::size_t fuera = empaquetar(texto + i, n - i, f.palabras + pos / SIMBOLOS_POR_PALABRA, plegar);
+        if (fuera > 0) {
+            for (std::size_t k = i; k < n; k++) {
+                if (simboloDe(texto[k], plegar) == ESCAPE) {
+                    agregarExcepcion(f, pos + (k - i), texto[k]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Agrega un carácter al final
+ */
+void MensajeEmpaquetado::agregar(char codificado, char decodificado) {
+    agregarCampo(ListaDeCarga::CODIFICADO, &codificado, 1);
+    agregarCampo(ListaDeCarga::DECODIFICADO, &decodificado, 1);
+    tamanio++;
+}
+
+/**
+ * Agrega un bloque de caracteres
+ */
+void MensajeEmpaquetado::agregarBloque(const char* codificados, const char* decodificados, std::size_t n) {
+    if (n == 0) return;
+    agregarCampo(ListaDeCarga::CODIFICADO, codificados, n);
+    agregarCampo(ListaDeCarga::DECODIFICADO, decodificados, n);
+    tamanio += n;
+}
+
+/**
+ * Empaqueta el contenido de una lista de carga
+ * Se exporta por bloques con los iteradores para usar el núcleo de empaquetado
+ */
+void MensajeEmpaquetado::agregarLista(const ListaDeCarga& lista) {
+    const std::size_t BLOQUE = 1200;  // Múltiplo de 12
+    char codificados[BLOQUE];
+    char decodificados[BLOQUE];
+    
+    ListaDeCarga::Iterador cod = lista.beginCodificado();
+    ListaDeCarga::Iterador finCod = lista.endCodificado();
+    ListaDeCarga::Iterador dec = lista.begin();
+    ListaDeCarga::Iterador fin = lista.end();
+    
+    // En modo ventana no hay campo codificado: no hay nada que archivar
+    while (dec != fin && cod != finCod) {
+        std::size_t n = 0;
+        while (dec != fin && cod != finCod && n < BLOQUE) {
+            codificados[n] = *cod++;
+            decodificados[n] = *dec++;
+            n++;
+        }
+        agregarBloque(codificados, decodificados, n);
+    }
+}
+
+/**
+ * Desempaqueta a un buffer y corrige las excepciones
+ */
+std::size_t MensajeEmpaquetado::copiarA(char* buffer, std::size_t capacidad,
+                                        ListaDeCarga::Campo campo) const {
+    if (buffer == nullptr || capacidad == 0) return 0;
+    
+    std::size_t n = (tamanio < capacidad - 1) ? tamanio : capacidad - 1;
+    const FlujoEmpaquetado& f = flujos[campo];
+    
+    if (n > 0) {
+        desempaquetar(f.palabras, n, buffer);
+    }
+    
+    for (std::size_t e = 0; e < f.numExcepciones && f.posExcepciones[e] < n; e++) {
+        buffer[f.posExcepciones[e]] = f.valExcepciones[e];
+    }
+    
+    buffer[n] = '\0';
+    return n;
+}
+
+/**
+ * Lee un carácter por posición: desempaqueta su palabra hasta él y, si es
+ * ESCAPE, busca la excepción (ordenadas por posición)
+ */
+char MensajeEmpaquetado::leer(std::size_t posicion, ListaDeCarga::Campo campo) const {
+    if (posicion >= tamanio) return '\0';
+    
+    const FlujoEmpaquetado& f = flujos[campo];
+    char tramo[SIMBOLOS_POR_PALABRA];
+    std::size_t k = posicion % SIMBOLOS_POR_PALABRA;
+    desempaquetar(f.palabras + posicion / SIMBOLOS_POR_PALABRA, k + 1, tramo);
+    if (tramo[k] != CARACTER_DE[ESCAPE]) return tramo[k];
+    
+    std::size_t bajo = 0;
+    std::size_t alto = f.numExcepciones;
+    while (bajo < alto) {
+        std::size_t medio = bajo + (alto - bajo) / 2;
+        if (f.posExcepciones[medio] < posicion) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    return (bajo < f.numExcepciones && f.posExcepciones[bajo] == posicion) ? f.valExcepciones[bajo] : tramo[k];
+}
+
+/**
+ * Imprime el campo decodificado palabra por palabra, sin desempaquetar
+ * el mensaje entero a un buffer
+ */
+void MensajeEmpaquetado::imprimirDecodificado(bool corchetes) const {
+    const FlujoEmpaquetado& f = flujos[ListaDeCarga::DECODIFICADO];
+    std::size_t e = 0;
+    char tramo[SIMBOLOS_POR_PALABRA];
+    
+    for (std::size_t inicio = 0; inicio < tamanio; inicio += SIMBOLOS_POR_PALABRA) {
+        std::size_t n = tamanio - inicio;
+        if (n > static_cast<std::size_t>(SIMBOLOS_POR_PALABRA)) n = SIMBOLOS_POR_PALABRA;
+        desempaquetar(f.palabras + inicio / SIMBOLOS_POR_PALABRA, n, tramo);
+        
+        // Las excepciones están ordenadas por posición
+        for (; e < f.numExcepciones && f.posExcepciones[e] < inicio + n; e++) {
+            tramo[f.posExcepciones[e] - inicio] = f.valExcepciones[e];
+        }
+        
+        if (corchetes) {
+            for (std::size_t k = 0; k < n; k++) {
+                std::cout << "[" << tramo[k] << "]";
+            }
+        } else {
+            std::cout.write(tramo, static_cast<std::streamsize>(n));
+        }
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Imprime el mensaje decodificado
+ */
+void MensajeEmpaquetado::imprimirMensaje() const {
+    if (tamanio == 0) {
+        std::cout << "[MENSAJE VACIO]" << std::endl;
+        return;
+    }
+    imprimirDecodificado(false);
+}
+
+/**
+ * Imprime el mensaje decodificado en formato [X][Y][Z]
+ */
+void MensajeEmpaquetado::imprimirMensajeParcial() const {
+    imprimirDecodificado(true);
+}
+
+/**
+ * Elimina el contenido
+ */
+void MensajeEmpaquetado::vaciar() {
+    for (int i = 0; i < 2; i++) {
+        flujos[i].numExcepciones = 0;
+    }
+    tamanio = 0;
+}
+
+/**
+ * Reduce cada flujo a las palabras y excepciones realmente usadas
+ */
+void MensajeEmpaquetado::ajustarMemoria() {
+    std::size_t palabrasUsadas = (tamanio + SIMBOLOS_POR_PALABRA - 1) / SIMBOLOS_POR_PALABRA;
+    
+    for (int i = 0; i < 2; i++) {
+        FlujoEmpaquetado& f = flujos[i];
+        
+        if (f.capPalabras > palabrasUsadas) {
+            unsigned long long* nuevas = (palabrasUsadas > 0) ? new unsigned long long[palabrasUsadas] : nullptr;
+            if (palabrasUsadas > 0) {
+                memcpy(nuevas, f.palabras, palabrasUsadas * sizeof(unsigned long long));
+            }
+            delete[] f.palabras;
+            f.palabras = nuevas;
+            f.capPalabras = palabrasUsadas;
+        }
+        
+        if (f.capExcepciones > f.numExcepciones) {
+            std::size_t* pos = nullptr;
+            char* val = nullptr;
+            if (f.numExcepciones > 0) {
+                pos = new std::size_t[f.numExcepciones];
+                val = new char[f.numExcepciones];
+                memcpy(pos, f.posExcepciones, f.numExcepciones * sizeof(std::size_t));
+                memcpy(val, f.valExcepciones, f.numExcepciones);
+            }
+            delete[] f.posExcepciones;
+            delete[] f.valExcepciones;
+            f.posExcepciones = pos;
+            f.valExcepciones = val;
+            f.capExcepciones = f.numExcepciones;
+        }
+    }
+}
+
+/**
+ * Obtiene el número de caracteres
+ */
+std::size_t MensajeEmpaquetado::obtenerTamanio() const {
+    return tamanio;
+}
+
+/**
+ * Bytes de memoria dinámica usados
+ */
+std::size_t MensajeEmpaquetado::bytesUsados() const {
+    std::size_t total = 0;
+    for (int i = 0; i < 2; i++) {
+        total += flujos[i].capPalabras * sizeof(unsigned long long);
+        total += flujos[i].capExcepciones * (sizeof(std::size_t) + sizeof(char));
+    }
+    return total;
+}
+
+/**
+ * Núcleo de empaquetado: 12 símbolos por palabra
+ */
+std::size_t MensajeEmpaquetado::empaquetar(const char* texto, std::size_t n, unsigned long long* palabras,
+                                           bool plegarMinusculas) {
+    std::size_t fuera = 0;
+    std::size_t completas = n / SIMBOLOS_POR_PALABRA;
+    
+    for (std::size_t w = 0; w < completas; w++) {
+        const char* t = texto + w * SIMBOLOS_POR_PALABRA;
+        unsigned long long palabra = 0;
+        for (int k = 0; k < SIMBOLOS_POR_PALABRA; k++) {
+            unsigned long long s = simboloDe(t[k], plegarMinusculas);
+            fuera += (s == ESCAPE);
+            palabra |= s << (k * 5);
+        }
+        palabras[w] = palabra;
+    }
+    
+    // Palabra final incompleta
+    std::size_t resto = n - completas * SIMBOLOS_POR_PALABRA;
+    if (resto > 0) {
+        const char* t = texto + completas * SIMBOLOS_POR_PALABRA;
+        unsigned long long palabra = 0;
+        for (std::size_t k = 0; k < resto; k++) {
+            unsigned long long s = simboloDe(t[k], plegarMinusculas);
+            fuera += (s == ESCAPE);
+            palabra |= s << (k * 5);
+        }
+        palabras[completas] = palabra;
+    }
+    
+    return fuera;
+}
+
+/**
+ * Núcleo de desempaquetado: 12 símbolos por palabra
+ */
+void MensajeEmpaquetado::desempaquetar(const unsigned long long* palabras, std::size_t n, char* texto) {
+    std::size_t completas = n / SIMBOLOS_POR_PALABRA;
+    
+    for (std::size_t w = 0; w < completas; w++) {
+        unsigned long long palabra = palabras[w];
+        char* t = texto + w * SIMBOLOS_POR_PALABRA;
+        for (int k = 0; k < SIMBOLOS_POR_PALABRA; k++) {
+            t[k] = CARACTER_DE[(palabra >> (k * 5)) & 31];
+        }
+    }
+    
+    std::size_t resto = n - completas * SIMBOLOS_POR_PALABRA;
+    if (resto > 0) {
+        unsigned long long palabra = palabras[completas];
+        char* t = texto + completas * SIMBOLOS_POR_PALABRA;
+        for (std::size_t k = 0; k < resto; k++) {
+            t[k] = CARACTER_DE[(palabra >> (k * 5)) & 31];
+        }
+    }
+}
@@ -0,0 +1,187 @@
+/**
+ * @file PlanificadorDeSesiones.cpp
+ * @brief Implementación del ciclo de eventos de sesiones PRT-7
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "PlanificadorDeSesiones.h"
+#include "SesionPRT7.h"
+#include "Trazas.h"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+
+/**
+ * Eventos atendidos por cada llamada a epoll_wait
+ */
+static const int MAX_EVENTOS = 256;
+
+/**
+ * Constructor de PlanificadorDeSesiones
+ */
+PlanificadorDeSesiones::PlanificadorDeSesiones(AlCerrar f, void* ctx)
+    : epollFd(-1), sesiones(nullptr), capSesiones(0), sesionesActivas(0),
+      bloque(new char[TAM_QUANTUM]), alCerrar(f), contexto(ctx), detenido(false),
+      bytesLeidos(0), lecturas(0) {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+}
+
+/**
+ * Destructor de PlanificadorDeSesiones
+ */
+PlanificadorDeSesiones::~PlanificadorDeSesiones() {
+    for (int i = 0; i < capSesiones; i++) {
+        if (sesiones[i] != nullptr) {
+            close(i);
+            delete sesiones[i];
+        }
+    }
+    delete[] sesiones;
+    delete[] bloque;
+    
+    if (epollFd >= 0) close(epollFd);
+}
+
+/**
+ * Registra una fuente en la tabla indexada por fd y en epoll
+ */
+bool PlanificadorDeSesiones::agregar(int fd, SesionPRT7* sesion) {
+    if (epollFd < 0 || fd < 0 || sesion == nullptr) return false;
+    if (fd < capSesiones && sesiones[fd] != nullptr) return false;
+    
+    // La tabla crece antes de tocar el descriptor: si falla no hay nada que deshacer
+    if (fd >= capSesiones) {
+        int nuevaCap = (capSesiones == 0) ? 1024 : capSesiones;
+        while (nuevaCap <= fd) nuevaCap *= 2;
+        
+        SesionPRT7** nueva = new SesionPRT7*[nuevaCap];
+        for (int i = 0; i < nuevaCap; i++) {
+            nueva[i] = (i < capSesiones) ? sesiones[i] : nullptr;
+        }
+        delete[] sesiones;
+        sesiones = nueva;
+        capSesiones = nuevaCap;
+    }
+    
+    int banderas = fcntl(fd, F_GETFL);
+    if (banderas < 0) return false;
+    if ((banderas & O_NONBLOCK) == 0 && fcntl(fd, F_SETFL, banderas | O_NONBLOCK) != 0) return false;
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        // El llamador conserva el descriptor tal como lo entregó
+        fcntl(fd, F_SETFL, banderas);
+        return false;
+    }
+    
+    sesiones[fd] = sesion;
+    sesionesActivas++;
+    return true;
+}
+
+/**
+ * Da un turno a una sesión: una sola lectura y de vuelta al ciclo
+ */
+void PlanificadorDeSesiones::atender(int fd) {
+    SesionPRT7* sesion = sesiones[fd];
+    
+    ssize_t n = read(fd, bloque, TAM_QUANTUM);
+    if (n > 0) {
+        bytesLeidos += static_cast<unsigned long long>(n);
+        lecturas++;
+        sesion->alimentar(bloque, static_cast<std::size_t>(n));
+        return;
+    }
+    
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return;
+    
+    // Fin de datos (o error): la última línea puede no tener '\n'
+    sesion->finalizar();
+    cerrar(fd);
+}
+
+/**
+ * Avisa, cierra el descriptor y libera la sesión
+ */
+void PlanificadorDeSesiones::cerrar(int fd) {
+    SesionPRT7* sesion = sesiones[fd];
+    if (alCerrar != nullptr) {
+        alCerrar(fd, sesion, contexto);
+    }
+    
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    sesiones[fd] = nullptr;
+    delete sesion;
+    sesionesActivas--;
+}
+
+/**
+ * Atiende una ronda de eventos
+ */
+int PlanificadorDeSesiones::atenderEventos(int esperaMs) {
+    PRT7_TRAZA("PlanificadorDeSesiones::atenderEventos");
+    
+    if (epollFd < 0) return -1;
+    
+    struct epoll_event eventos[MAX_EVENTOS];
+    int n = epoll_wait(epollFd, eventos, MAX_EVENTOS, esperaMs);
+    if (n < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        int fd = eventos[i].data.fd;
+        if (fd < 0 || fd >= capSesiones || sesiones[fd] == nullptr) continue;
+        
+        // EPOLLHUP/EPOLLERR: read() entrega lo que quede y después 0 o el error
+        atender(fd);
+    }
+    
+    return n;
+}
+
+/**
+ * Atiende eventos hasta que no queden fuentes o se llame a detener()
+ */
+void PlanificadorDeSesiones::ejecutar() {
+    detenido = false;
+    while (!detenido && sesionesActivas > 0) {
+        if (atenderEventos(-1) < 0) break;
+    }
+}
+
+/**
+ * Pide a ejecutar() que termine
+ */
+void PlanificadorDeSesiones::detener() {
+    detenido = true;
+}
+
+/**
+ * Obtiene el número de fuentes registradas
+ */
+int PlanificadorDeSesiones::obtenerSesionesActivas() const {
+    return sesionesActivas;
+}
+
+/**
+ * Obtiene los bytes entregados a las sesiones
+ */
+unsigned long long PlanificadorDeSesiones::obtenerBytesLeidos() const {
+    return bytesLeidos;
+}
+
+/**
+ * Obtiene el número de turnos con datos
+ */
+unsigned long long PlanificadorDeSesiones::obtenerLecturas() const {
+    return lecturas;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file PoolDeTrabajo.cpp
+ * @brief Implementación del grupo de hilos con robo de trabajo
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "PoolDeTrabajo.h"
+#include "Trazas.h"
+
+/**
+ * Constructor de PoolDeTrabajo
+ */
+PoolDeTrabajo::PoolDeTrabajo(int hilosPedidos)
+    : numHilos(hilosPedidos), hilos(nullptr), colas(nullptr), lote(0), pendientes(0),
+      activos(0), terminar(false), robos(0) {
+    if (numHilos <= 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+        if (numHilos <= 0) numHilos = 1;
+    }
+    
+    colas = new ColaDeTrabajo[numHilos];
+    hilos = new std::thread[numHilos];
+    for (int i = 0; i < numHilos; i++) {
+        hilos[i] = std::thread(&PoolDeTrabajo::trabajar, this, i);
+    }
+}
+
+/**
+ * Destructor de PoolDeTrabajo
+ */
+PoolDeTrabajo::~PoolDeTrabajo() {
+    esperar();
+    
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        terminar = true;
+    }
+    hayTrabajo.notify_all();
+    
+    for (int i = 0; i < numHilos; i++) {
+        hilos[i].join();
+    }
+    
+    delete[] hilos;
+    delete[] colas;
+}
+
+/**
+ * Reparte el lote en tramos contiguos y despierta a los hilos
+ */
+void PoolDeTrabajo::lanzar(int numTareas, Tarea f, void* ctx) {
+    if (numTareas <= 0) return;
+    
+    std::lock_guard<std::mutex> guardia(mutex);
+    pendientes.store(numTareas);
+    
+    for (int i = 0; i < numHilos; i++) {
+        std::lock_guard<std::mutex> guardiaCola(colas[i].mutex);
+        colas[i].inicio = static_cast<int>(static_cast<long long>(numTareas) * i / numHilos);
+        colas[i].fin = static_cast<int>(static_cast<long long>(numTareas) * (i + 1) / numHilos);
+        colas[i].tarea = f;
+        colas[i].contexto = ctx;
+    }
+    
+    lote++;
+    hayTrabajo.notify_all();
+}
+
+/**
+ * Espera a que terminen todas las tareas del lote
+ */
+void PoolDeTrabajo::esperar() {
+    std::unique_lock<std::mutex> guardia(mutex);
+    while (pendientes.load() > 0 || activos > 0) {
+        loteTerminado.wait(guardia);
+    }
+}
+
+/**
+ * Toma una tarea de la cola propia o la roba de otra
+ */
+int PoolDeTrabajo::tomarTarea(int hilo, Tarea* f, void** ctx) {
+    {
+        ColaDeTrabajo& propia = colas[hilo];
+        std::lock_guard<std::mutex> guardia(propia.mutex);
+        if (propia.inicio < propia.fin) {
+            *f = propia.tarea;
+            *ctx = propia.contexto;
+            return propia.inicio++;
+        }
+    }
+    
+    // Robar del final de las otras colas (lo más lejano a su dueño)
+    for (int k = 1; k < numHilos; k++) {
+        ColaDeTrabajo& victima = colas[(hilo + k) % numHilos];
+        std::lock_guard<std::mutex> guardia(victima.mutex);
+        if (victima.inicio < victima.fin) {
+            robos++;
+            *f = victima.tarea;
+            *ctx = victima.contexto;
+            return --victima.fin;
+        }
+    }
+    
+    return -1;
+}
+
+/**
+ * Ciclo de un hilo trabajador: dormir hasta un lote nuevo y vaciarlo
+ */
+void PoolDeTrabajo::trabajar(int hilo) {
+    unsigned long visto = 0;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guardia(mutex);
+            while (!terminar && lote == visto) {
+                hayTrabajo.wait(guardia);
+            }
+            if (terminar) return;
+            visto = lote;
+            activos++;
+        }
+        
+        Tarea f;
+        void* ctx;
+        int indice;
+        while ((indice = tomarTarea(hilo, &f, &ctx)) >= 0) {
+            {
+                PRT7_TRAZA("PoolDeTrabajo::tarea");
+                f(indice, hilo, ctx);
+            }
+            
+            pendientes.fetch_sub(1);
+        }
+        
+        {
+            std::lock_guard<std::mutex> guardia(mutex);
+            if (--activos == 0) {
+                loteTerminado.notify_all();
+            }
+        }
+    }
+}
+
+/**
+ * Obtiene el número de hilos
+ */
+int PoolDeTrabajo::obtenerNumHilos() const {
+    return numHilos;
+}
+
+/**
+ * Obtiene el número de tareas robadas
+ */
+unsigned long long PoolDeTrabajo::obtenerRobos() const {
+    return robos.load();
+}
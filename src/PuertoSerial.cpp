@@ -0,0 +1,158 @@
+/**
+ * @file PuertoSerial.cpp
+ * @brief Implementación de la configuración del puerto serial
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "PuertoSerial.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+/**
+ * Nombre de un perfil para la línea de comandos y los reportes
+ */
+const char* nombrePerfil(PerfilSerial perfil) {
+    switch (perfil) {
+        case PERFIL_BAJA_LATENCIA: return "latencia";
+        case PERFIL_VOLUMEN: return "volumen";
+        default: return "clasico";
+    }
+}
+
+/**
+ * Bytes por read() de cada perfil
+ */
+int tamLecturaPerfil(PerfilSerial perfil) {
+    return (perfil == PERFIL_VOLUMEN) ? 4096 : 256;
+}
+
+/**
+ * Convierte baudios a la constante de termios
+ */
+bool velocidadTermios(int baudios, speed_t* velocidad) {
+    static const struct {
+        int baudios;
+        speed_t constante;
+    } VELOCIDADES[] = {
+        {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+        {115200, B115200}, {230400, B230400},
+#ifdef B4000000
+        {460800, B460800}, {500000, B500000}, {576000, B576000}, {921600, B921600},
+        {1000000, B1000000}, {1152000, B1152000}, {1500000, B1500000}, {2000000, B2000000},
+        {2500000, B2500000}, {3000000, B3000000}, {3500000, B3500000}, {4000000, B4000000},
+#endif
+    };
+    
+    for (size_t i = 0; i < sizeof(VELOCIDADES) / sizeof(VELOCIDADES[0]); i++) {
+        if (VELOCIDADES[i].baudios == baudios) {
+            *velocidad = VELOCIDADES[i].constante;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Activa o desactiva ASYNC_LOW_LATENCY (false si el driver no lo soporta)
+ */
+bool configurarBajaLatencia(int fd, bool activar) {
+#if defined(__linux__) && defined(ASYNC_LOW_LATENCY)
+    struct serial_struct serie;
+    if (ioctl(fd, TIOCGSERIAL, &serie) != 0) return false;
+    
+    if (activar) {
+        serie.flags |= ASYNC_LOW_LATENCY;
+    } else {
+        serie.flags &= ~ASYNC_LOW_LATENCY;
+    }
+    return ioctl(fd, TIOCSSERIAL, &serie) == 0;
+#else
+    (void)fd;
+    (void)activar;
+    return false;
+#endif
+}
+
+/**
+ * Abre el puerto en 8N1 no canónico con el VMIN/VTIME del perfil
+ */
+int configurarPuertoSerial(const char* portName, int baudios, PerfilSerial perfil, bool* bajaLatencia) {
+    if (bajaLatencia != nullptr) *bajaLatencia = false;
+    
+    speed_t velocidad;
+    if (!velocidadTermios(baudios, &velocidad)) {
+        return -1;
+    }
+    
+    int serial_port = open(portName, O_RDONLY | O_NOCTTY);
+    
+    if (serial_port < 0) {
+        return -1;
+    }
+    
+    struct termios tty;
+    if (tcgetattr(serial_port, &tty) != 0) {
+        close(serial_port);
+        return -1;
+    }
+    
+    // Configurar baudrate
+    cfsetispeed(&tty, velocidad);
+    cfsetospeed(&tty, velocidad);
+    
+    // 8N1
+    tty.c_cflag &= ~PARENB;        // Sin paridad
+    tty.c_cflag &= ~CSTOPB;        // 1 bit de parada
+    tty.c_cflag &= ~CSIZE;
+    tty.c_cflag |= CS8;            // 8 bits
+    
+    tty.c_cflag &= ~CRTSCTS;       // Sin control de flujo hardware
+    tty.c_cflag |= CREAD | CLOCAL; // Activar lectura
+    
+    tty.c_lflag &= ~ICANON;        // Modo no canónico
+    tty.c_lflag &= ~ECHO;
+    tty.c_lflag &= ~ECHOE;
+    tty.c_lflag &= ~ECHONL;
+    tty.c_lflag &= ~ISIG;
+    
+    tty.c_iflag &= ~(IXON | IXOFF | IXANY); // Sin control de flujo software
+    tty.c_iflag &= ~(IGNBRK|BRKINT|PARMRK|ISTRIP|INLCR|IGNCR|ICRNL);
+    
+    tty.c_oflag &= ~OPOST;
+    tty.c_oflag &= ~ONLCR;
+    
+    switch (perfil) {
+        case PERFIL_BAJA_LATENCIA:
+        case PERFIL_VOLUMEN:
+            // Sin temporizador: vuelve con todo lo que haya desde el primer
+            // byte. Con VMIN grande n_tty entrega de 64 en 64 bytes: el volumen
+            // sale del read() de 4096 y del temporizador del adaptador.
+            tty.c_cc[VTIME] = 0;
+            tty.c_cc[VMIN] = 1;
+            break;
+        default:
+            tty.c_cc[VTIME] = 10;  // Timeout de 1 segundo
+            tty.c_cc[VMIN] = 0;
+            break;
+    }
+    
+    if (tcsetattr(serial_port, TCSANOW, &tty) != 0) {
+        close(serial_port);
+        return -1;
+    }
+    
+    // Latencia del driver: baja solo en el perfil de latencia; en volumen se
+    // deja que el adaptador junte bytes
+    if (perfil != PERFIL_CLASICO) {
+        bool aplicada = configurarBajaLatencia(serial_port, perfil == PERFIL_BAJA_LATENCIA);
+        if (bajaLatencia != nullptr) *bajaLatencia = aplicada && perfil == PERFIL_BAJA_LATENCIA;
+    }
+    
+    return serial_port;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file ResincronizadorPRT7.cpp
+ * @brief Implementación de la resincronización con salida provisional
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "ResincronizadorPRT7.h"
+#include "BufferDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include <cstring>
+
+/**
+ * Copia el mensaje decodificado de una lista a un arreglo nuevo
+ */
+static char* copiarMensaje(const ListaDeCarga* carga, std::size_t* longitud) {
+    std::size_t tamanio = static_cast<std::size_t>(carga->obtenerTamanio());
+    char* mensaje = new char[tamanio + 1];
+    *longitud = carga->copiarA(mensaje, tamanio + 1);
+    return mensaje;
+}
+
+/**
+ * Decodifica las tramas guardadas con el rotor en un desplazamiento dado
+ * 
+ * La lista es propia y completa: no depende de la ventana o del modo
+ * de almacenamiento que use la sesión.
+ */
+static char* decodificarTramas(BufferDeTramas* tramas, int desplazamiento, std::size_t* longitud) {
+    RotorDeMapeo rotor;
+    ListaDeCarga carga;
+    rotor.rotar(desplazamiento);
+    tramas->ejecutar(&carga, &rotor);
+    return copiarMensaje(&carga, longitud);
+}
+
+/**
+ * Constructor de ResincronizadorPRT7
+ */
+ResincronizadorPRT7::ResincronizadorPRT7()
+    : estado(PROVISIONAL), veredicto(PENDIENTE), parcial(nullptr), referencia(nullptr),
+      corregido(nullptr), longCorregido(0),
+      desplazamientoInicial(-1) {
+    parcial = new BufferDeTramas(64);
+    referencia = new BufferDeTramas(64);
+}
+
+/**
+ * Destructor de ResincronizadorPRT7
+ */
+ResincronizadorPRT7::~ResincronizadorPRT7() {
+    delete parcial;
+    delete referencia;
+    delete[] corregido;
+}
+
+/**
+ * Guarda una línea de trama en el buffer de la fase actual
+ */
+void ResincronizadorPRT7::registrarLinea(const char* linea, std::size_t longitud) {
+    if (estado == SINCRONIZADO) return;
+    
+    BufferDeTramas* destino = (estado == PROVISIONAL) ? parcial : referencia;
+    destino->parsearBloque(linea, longitud);
+    destino->parsearBloque("\n", 1);
+}
+
+/**
+ * Busca la secuencia parcial como sufijo de la referencia
+ * 
+ * Ambas terminan en el mismo marcador de reinicio, así que la
+ * alineación es única: se comparan las últimas tramas de la referencia.
+ */
+int ResincronizadorPRT7::alinear() const {
+    int numParcial = parcial->obtenerNumTramas();
+    int numReferencia = referencia->obtenerNumTramas();
+    if (numParcial > numReferencia) return -1;
+    
+    int inicio = numReferencia - numParcial;
+    for (int i = 0; i < numParcial; i++) {
+        if (parcial->getEtiqueta(i) != referencia->getEtiqueta(inicio + i) ||
+            parcial->getCarga(i) != referencia->getCarga(inicio + i)) {
+            return -1;
+        }
+    }
+    
+    // Rotación acumulada del guion antes del sufijo
+    long long total = 0;
+    for (int i = 0; i < inicio; i++) {
+        if (referencia->getEtiqueta(i) == BufferDeTramas::MAPEO) {
+            total += referencia->getCarga(i);
+        }
+    }
+    int desplazamiento = static_cast<int>(total % 27);
+    return (desplazamiento < 0) ? desplazamiento + 27 : desplazamiento;
+}
+
+/**
+ * Verifica la secuencia parcial y la recalcula si hace falta
+ */
+void ResincronizadorPRT7::verificar() {
+    estado = SINCRONIZADO;
+    desplazamientoInicial = alinear();
+    
+    if (desplazamientoInicial < 0) {
+        veredicto = NO_VERIFICABLE;
+    } else if (desplazamientoInicial == 0) {
+        // El rotor ya estaba en 'A': la salida provisional es la correcta
+        veredicto = CONFIRMADO;
+    } else {
+        // Las dos versiones salen de las mismas tramas: la lista de la
+        // sesión puede guardar solo una parte del mensaje (ventana)
+        std::size_t longProvisional = 0;
+        char* provisional = decodificarTramas(parcial, 0, &longProvisional);
+        
+        delete[] corregido;
+        corregido = decodificarTramas(parcial, desplazamientoInicial, &longCorregido);
+        
+        bool igual = (longCorregido == longProvisional) &&
+                     memcmp(corregido, provisional, longCorregido) == 0;
+        veredicto = igual ? CONFIRMADO : CORREGIDO;
+        delete[] provisional;
+    }
+    
+    // Las tramas crudas ya no se necesitan
+    parcial->limpiar();
+    referencia->limpiar();
+}
+
+/**
+ * Procesa un marcador de reinicio de secuencia
+ */
+ResincronizadorPRT7::Veredicto ResincronizadorPRT7::cerrarSecuencia() {
+    if (estado == PROVISIONAL && parcial->obtenerNumTramas() == 0) {
+        // Conectado justo en el marcador: no hay nada que verificar
+        estado = SINCRONIZADO;
+        veredicto = CONFIRMADO;
+        desplazamientoInicial = 0;
+    } else if (estado == PROVISIONAL) {
+        estado = CAPTURANDO;
+    } else if (estado == CAPTURANDO) {
+        verificar();
+    }
+    return veredicto;
+}
+
+/**
+ * Vuelve a la fase PROVISIONAL descartando todo lo guardado
+ */
+void ResincronizadorPRT7::reiniciar() {
+    estado = PROVISIONAL;
+    veredicto = PENDIENTE;
+    desplazamientoInicial = -1;
+    
+    parcial->limpiar();
+    referencia->limpiar();
+    
+    delete[] corregido;
+    corregido = nullptr;
+    longCorregido = 0;
+}
+
+/**
+ * Obtiene la fase actual
+ */
+ResincronizadorPRT7::Estado ResincronizadorPRT7::obtenerEstado() const {
+    return estado;
+}
+
+/**
+ * Verifica si la salida actual es provisional
+ */
+bool ResincronizadorPRT7::esProvisional() const {
+    return estado == PROVISIONAL;
+}
+
+/**
+ * Verifica si la secuencia parcial ya fue verificada
+ */
+bool ResincronizadorPRT7::estaSincronizado() const {
+    return estado == SINCRONIZADO;
+}
+
+/**
+ * Obtiene el veredicto de la verificación
+ */
+ResincronizadorPRT7::Veredicto ResincronizadorPRT7::obtenerVeredicto() const {
+    return veredicto;
+}
+
+/**
+ * Obtiene el desplazamiento del rotor al conectarse
+ */
+int ResincronizadorPRT7::obtenerDesplazamientoInicial() const {
+    return desplazamientoInicial;
+}
+
+/**
+ * Obtiene el mensaje recalculado
+ */
+const char* ResincronizadorPRT7::obtenerCorregido() const {
+    return corregido;
+}
+
+/**
+ * Obtiene la longitud del mensaje recalculado
+ */
+std::size_t ResincronizadorPRT7::obtenerLongCorregido() const {
+    return longCorregido;
+}
@@ -7,6 +7,7 @@
  */
 
 #include "RotorDeMapeo.h"
+#include "Trazas.h"
 #include <iostream>
 
 /**
@@ -29,7 +30,6 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
             // Primer nodo
             primerNodo = nuevoNodo;
             ultimoNodo = nuevoNodo;
-            cabeza = nuevoNodo;
         } else {
             // Enlazar con el anterior
             ultimoNodo->siguiente = nuevoNodo;
@@ -45,6 +45,9 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
         ultimoNodo->siguiente = primerNodo;
         primerNodo->previo = ultimoNodo;
     }
+    
+    // Publicar la cabeza ya con el círculo completo
+    cabeza.store(primerNodo, std::memory_order_release);
 }
 
 /**
@@ -52,21 +55,22 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
  * Libera toda la memoria de los nodos
  */
 RotorDeMapeo::~RotorDeMapeo() {
-    if (cabeza == nullptr) return;
+    NodoRotor* inicio = cabeza.load(std::memory_order_relaxed);
+    if (inicio == nullptr) return;
     
     // Romper el círculo
-    NodoRotor* ultimoNodo = cabeza->previo;
+    NodoRotor* ultimoNodo = inicio->previo;
     ultimoNodo->siguiente = nullptr;
     
     // Eliminar todos los nodos
-    NodoRotor* actual = cabeza;
+    NodoRotor* actual = inicio;
     while (actual != nullptr) {
         NodoRotor* siguiente = actual->siguiente;
         delete actual;
         actual = siguiente;
     }
     
-    cabeza = nullptr;
+    cabeza.store(nullptr, std::memory_order_relaxed);
     tamanio = 0;
 }
 
@@ -74,15 +78,16 @@ RotorDeMapeo::~RotorDeMapeo() {
  * Encuentra un nodo por su carácter
  */
 NodoRotor* RotorDeMapeo::encontrarNodo(char c) const {
-    if (cabeza == nullptr) return nullptr;
+    NodoRotor* inicio = cabeza.load(std::memory_order_acquire);
+    if (inicio == nullptr) return nullptr;
     
-    NodoRotor* actual = cabeza;
+    NodoRotor* actual = inicio;
     do {
         if (actual->dato == c) {
             return actual;
         }
         actual = actual->siguiente;
-    } while (actual != cabeza);
+    } while (actual != inicio);
     
     return nullptr;
 }
@@ -108,7 +113,11 @@ int RotorDeMapeo::calcularDistancia(NodoRotor* desde, NodoRotor* hasta) const {
  * Rota el rotor N posiciones
  */
 void RotorDeMapeo::rotar(int n) {
-    if (cabeza == nullptr || tamanio == 0) return;
+    PRT7_TRAZA("RotorDeMapeo::rotar");
+    
+    // Solo el hilo escritor modifica la cabeza: lectura relajada
+    NodoRotor* nuevaCabeza = cabeza.load(std::memory_order_relaxed);
+    if (nuevaCabeza == nullptr || tamanio == 0) return;
     
     // Normalizar n al rango [-tamanio, tamanio]
     n = n % tamanio;
@@ -116,14 +125,17 @@ void RotorDeMapeo::rotar(int n) {
     if (n > 0) {
         // Rotar hacia adelante
         for (int i = 0; i < n; i++) {
-            cabeza = cabeza->siguiente;
+            nuevaCabeza = nuevaCabeza->siguiente;
         }
     } else if (n < 0) {
         // Rotar hacia atrás
         for (int i = 0; i > n; i--) {
-            cabeza = cabeza->previo;
+            nuevaCabeza = nuevaCabeza->previo;
         }
     }
+    
+    // Una sola publicación: los lectores nunca ven un estado intermedio
+    cabeza.store(nuevaCabeza, std::memory_order_release);
 }
 
 /**
@@ -131,7 +143,11 @@ void RotorDeMapeo::rotar(int n) {
  * Implementa el cifrado César dinámico
  */
 char RotorDeMapeo::getMapeo(char in) const {
-    if (cabeza == nullptr) return in;
+    PRT7_TRAZA("RotorDeMapeo::getMapeo");
+    
+    // Leer la cabeza una sola vez: todo el mapeo usa el mismo estado
+    NodoRotor* inicio = cabeza.load(std::memory_order_acquire);
+    if (inicio == nullptr) return in;
     
     // El espacio NUNCA se rota, siempre se mantiene como espacio
     if (in == ' ') {
@@ -152,7 +168,7 @@ char RotorDeMapeo::getMapeo(char in) const {
     }
     
     // Aplicar el offset desde la cabeza actual
-    NodoRotor* nodoSalida = cabeza;
+    NodoRotor* nodoSalida = inicio;
     for (int i = 0; i < offsetDesdeA; i++) {
         nodoSalida = nodoSalida->siguiente;
     }
@@ -164,6 +180,17 @@ char RotorDeMapeo::getMapeo(char in) const {
  * Obtiene la posición actual del rotor
  */
 char RotorDeMapeo::getPosicionActual() const {
-    if (cabeza == nullptr) return '?';
-    return cabeza->dato;
+    NodoRotor* actual = cabeza.load(std::memory_order_acquire);
+    if (actual == nullptr) return '?';
+    return actual->dato;
+}
+
+/**
+ * Regresa la cabeza del rotor a 'A'
+ */
+void RotorDeMapeo::reiniciar() {
+    NodoRotor* nodoA = encontrarNodo('A');
+    if (nodoA != nullptr) {
+        cabeza.store(nodoA, std::memory_order_release);
+    }
 }
@@ -0,0 +1,487 @@
+/**
+ * @file ServidorPRT7.cpp
+ * @brief Implementación del servidor de ingesta PRT-7 (epoll)
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "ServidorPRT7.h"
+#include "SesionPRT7.h"
+#include "ListaDeCarga.h"
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/**
+ * Eventos atendidos por cada llamada a epoll_wait
+ */
+static const int MAX_EVENTOS = 256;
+
+/**
+ * Bytes leídos por cada lectura de una conexión
+ */
+static const int TAM_LECTURA = 16384;
+
+/**
+ * Constructor de SesionConexion
+ */
+SesionConexion::SesionConexion(int f, ServidorPRT7* srv)
+    : fd(f), servidor(srv), sesion(nullptr), salida(nullptr), longSalida(0), capSalida(0),
+      finEntrada(false), eventos(0) {
+    sesion = new SesionPRT7(srv->numRotores, ServidorPRT7::alEvento, this);
+}
+
+/**
+ * Destructor de SesionConexion
+ */
+SesionConexion::~SesionConexion() {
+    delete sesion;
+    delete[] salida;
+}
+
+/**
+ * Agrega bytes a la salida pendiente, creciendo el buffer si es necesario
+ */
+void SesionConexion::agregarSalida(const char* datos, std::size_t longitud) {
+    if (longSalida + longitud > capSalida) {
+        std::size_t nuevaCap = (capSalida == 0) ? 256 : capSalida * 2;
+        while (nuevaCap < longSalida + longitud) nuevaCap *= 2;
+        
+        char* nueva = new char[nuevaCap];
+        if (longSalida > 0) memcpy(nueva, salida, longSalida);
+        delete[] salida;
+        salida = nueva;
+        capSalida = nuevaCap;
+    }
+    memcpy(salida + longSalida, datos, longitud);
+    longSalida += longitud;
+}
+
+/**
+ * Constructor de ServidorPRT7
+ */
+ServidorPRT7::ServidorPRT7(int rotores) : epollFd(-1), escuchaFd(-1), despertarFd(-1), reservaFd(-1),
+                                          sesiones(nullptr), capSesiones(0),
+                                          numRotores(rotores < 1 ? 1 : rotores), detenido(false),
+                                          conexionesTotales(0), conexionesRechazadas(0),
+                                          conexionesActivas(0), tramasProcesadas(0), mensajesEnviados(0) {
+    rutaUnix[0] = '\0';
+    
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    despertarFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    reservaFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    
+    if (epollFd >= 0 && despertarFd >= 0) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = despertarFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, despertarFd, &ev);
+    }
+}
+
+/**
+ * Destructor de ServidorPRT7
+ */
+ServidorPRT7::~ServidorPRT7() {
+    for (int i = 0; i < capSesiones; i++) {
+        if (sesiones[i] != nullptr) {
+            close(sesiones[i]->fd);
+            delete sesiones[i];
+        }
+    }
+    delete[] sesiones;
+    
+    if (escuchaFd >= 0) close(escuchaFd);
+    if (despertarFd >= 0) close(despertarFd);
+    if (reservaFd >= 0) close(reservaFd);
+    if (epollFd >= 0) close(epollFd);
+    if (rutaUnix[0] != '\0') unlink(rutaUnix);
+}
+
+/**
+ * Registra el socket de escucha en epoll
+ */
+bool ServidorPRT7::prepararEscucha(int fd) {
+    if (listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    escuchaFd = fd;
+    return true;
+}
+
+/**
+ * Escucha en un socket UNIX
+ */
+bool ServidorPRT7::escucharUnix(const char* ruta) {
+    if (epollFd < 0 || escuchaFd >= 0) return false;
+    
+    struct sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (strlen(ruta) >= sizeof(direccion.sun_path)) return false;
+    strcpy(direccion.sun_path, ruta);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    
+    unlink(ruta);
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&direccion), sizeof(direccion)) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    if (!prepararEscucha(fd)) {
+        unlink(ruta);
+        return false;
+    }
+    
+    strcpy(rutaUnix, ruta);
+    return true;
+}
+
+/**
+ * Escucha en TCP (127.0.0.1)
+ */
+int ServidorPRT7::escucharTcp(int puerto) {
+    if (epollFd < 0 || escuchaFd >= 0) return -1;
+    
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    
+    int uno = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+    
+    struct sockaddr_in direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons(static_cast<unsigned short>(puerto));
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&direccion), sizeof(direccion)) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    socklen_t longitud = sizeof(direccion);
+    getsockname(fd, reinterpret_cast<struct sockaddr*>(&direccion), &longitud);
+    
+    if (!prepararEscucha(fd)) return -1;
+    return ntohs(direccion.sin_port);
+}
+
+/**
+ * Guarda la sesión en la tabla indexada por fd y la registra en epoll
+ */
+void ServidorPRT7::registrarSesion(SesionConexion* s) {
+    if (s->fd >= capSesiones) {
+        int nuevaCap = (capSesiones == 0) ? 1024 : capSesiones;
+        while (nuevaCap <= s->fd) nuevaCap *= 2;
+        
+        SesionConexion** nueva = new SesionConexion*[nuevaCap];
+        for (int i = 0; i < nuevaCap; i++) {
+            nueva[i] = (i < capSesiones) ? sesiones[i] : nullptr;
+        }
+        delete[] sesiones;
+        sesiones = nueva;
+        capSesiones = nuevaCap;
+    }
+    sesiones[s->fd] = s;
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLRDHUP;
+    ev.data.fd = s->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, s->fd, &ev);
+    s->eventos = ev.events;
+    
+    conexionesTotales++;
+    conexionesActivas++;
+}
+
+/**
+ * Acepta todas las conexiones pendientes
+ */
+void ServidorPRT7::aceptarConexiones() {
+    while (true) {
+        int fd = accept4(escuchaFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd >= 0) {
+            registrarSesion(new SesionConexion(fd, this));
+            continue;
+        }
+        
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        
+        if ((errno == EMFILE || errno == ENFILE) && reservaFd >= 0) {
+            // Sin descriptores la conexión se queda en la cola y el socket
+            // de escucha (por nivel) despertaría a epoll sin parar: liberar
+            // la reserva, aceptar y cerrar la conexión, y recuperar la reserva
+            close(reservaFd);
+            fd = accept4(escuchaFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                close(fd);
+                conexionesRechazadas++;
+            }
+            reservaFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) continue;
+        }
+        
+        // EAGAIN: no hay más pendientes
+        return;
+    }
+}
+
+/**
+ * Fin de una secuencia con mensaje: lo encola para el cliente
+ * 
+ * Durante FIN_SECUENCIA la lista de la sesión aún tiene el mensaje.
+ * Una secuencia sin cargas (solo MAPs) no genera respuesta.
+ */
+void ServidorPRT7::alEvento(const EventoPRT7* evento, void* contexto) {
+    if (evento->tipo != EventoPRT7::FIN_SECUENCIA || evento->longitudMensaje == 0) return;
+    SesionConexion* s = static_cast<SesionConexion*>(contexto);
+    
+    const ListaDeCarga* carga = s->sesion->obtenerCarga();
+    std::size_t longitud = static_cast<std::size_t>(carga->obtenerTamanio());
+    char* mensaje = new char[longitud + 2];
+    std::size_t copiados = carga->copiarA(mensaje, longitud + 1);
+    mensaje[copiados] = '\n';
+    
+    s->agregarSalida(mensaje, copiados + 1);
+    s->servidor->mensajesEnviados++;
+    delete[] mensaje;
+}
+
+/**
+ * Envía lo posible de la salida pendiente
+ * @return false si la conexión falló
+ */
+bool ServidorPRT7::enviarPendiente(SesionConexion* s) {
+    std::size_t enviados = 0;
+    while (enviados < s->longSalida) {
+        ssize_t n = send(s->fd, s->salida + enviados, s->longSalida - enviados, MSG_NOSIGNAL);
+        if (n > 0) {
+            enviados += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    
+    if (enviados > 0) {
+        memmove(s->salida, s->salida + enviados, s->longSalida - enviados);
+        s->longSalida -= enviados;
+    }
+    
+    actualizarEventos(s);
+    return true;
+}
+
+/**
+ * Ajusta los eventos de epoll de una conexión a su estado
+ * 
+ * EPOLLOUT solo mientras haya datos atorados; EPOLLIN mientras el
+ * cliente siga enviando y la salida pendiente no llegue al límite.
+ */
+void ServidorPRT7::actualizarEventos(SesionConexion* s) {
+    uint32_t eventos = 0;
+    if (!s->finEntrada && s->longSalida < LIMITE_SALIDA) {
+        eventos |= static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP);
+    }
+    if (s->longSalida > 0) {
+        eventos |= static_cast<uint32_t>(EPOLLOUT);
+    }
+    
+    if (eventos == s->eventos) return;
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = eventos;
+    ev.data.fd = s->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, s->fd, &ev);
+    s->eventos = eventos;
+}
+
+/**
+ * Lee y decodifica lo disponible en una conexión
+ */
+void ServidorPRT7::atenderLectura(SesionConexion* s) {
+    char bloque[TAM_LECTURA];
+    ssize_t n = read(s->fd, bloque, sizeof(bloque));
+    
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+        cerrarSesion(s);
+        return;
+    }
+    
+    unsigned long long tramasAntes = s->sesion->obtenerTramasTotales();
+    if (n > 0) {
+        s->sesion->alimentar(bloque, static_cast<std::size_t>(n));
+    } else {
+        // El cliente terminó de enviar: la última línea y la última
+        // secuencia pueden no tener terminador
+        s->finEntrada = true;
+        s->sesion->finalizar();
+        
+        const ListaDeCarga* carga = s->sesion->obtenerCarga();
+        if (!carga->estaVacia()) {
+            EventoPRT7 fin;
+            memset(&fin, 0, sizeof(fin));
+            fin.tipo = EventoPRT7::FIN_SECUENCIA;
+            fin.longitudMensaje = static_cast<std::size_t>(carga->obtenerTamanio());
+            alEvento(&fin, s);
+        }
+    }
+    tramasProcesadas += s->sesion->obtenerTramasTotales() - tramasAntes;
+    
+    if (!enviarPendiente(s) || (s->finEntrada && s->longSalida == 0)) {
+        cerrarSesion(s);
+    }
+}
+
+/**
+ * Cierra una conexión y libera su sesión
+ */
+void ServidorPRT7::cerrarSesion(SesionConexion* s) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, s->fd, nullptr);
+    close(s->fd);
+    sesiones[s->fd] = nullptr;
+    delete s;
+    conexionesActivas--;
+}
+
+/**
+ * Atiende una ronda de eventos
+ */
+int ServidorPRT7::atenderEventos(int esperaMs) {
+    if (epollFd < 0) return -1;
+    
+    struct epoll_event eventos[MAX_EVENTOS];
+    int n = epoll_wait(epollFd, eventos, MAX_EVENTOS, esperaMs);
+    if (n < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        int fd = eventos[i].data.fd;
+        
+        if (fd == escuchaFd) {
+            aceptarConexiones();
+            continue;
+        }
+        
+        if (fd == despertarFd) {
+            unsigned long long valor;
+            ssize_t r = read(despertarFd, &valor, sizeof(valor));
+            (void)r;
+            continue;
+        }
+        
+        if (fd < 0 || fd >= capSesiones || sesiones[fd] == nullptr) continue;
+        SesionConexion* s = sesiones[fd];
+        
+        if (eventos[i].events & EPOLLERR) {
+            cerrarSesion(s);
+            continue;
+        }
+        
+        if ((eventos[i].events & EPOLLOUT) && !enviarPendiente(s)) {
+            cerrarSesion(s);
+            continue;
+        }
+        
+        if (s->finEntrada) {
+            if (s->longSalida == 0) cerrarSesion(s);
+            continue;
+        }
+        
+        // Con la lectura pausada EPOLLHUP sigue llegando: no leer hasta
+        // que la salida baje del límite
+        if ((s->eventos & EPOLLIN) && (eventos[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) {
+            atenderLectura(s);
+        }
+    }
+    
+    return n;
+}
+
+/**
+ * Atiende eventos hasta que se llame a detener()
+ */
+void ServidorPRT7::ejecutar() {
+    detenido = false;
+    while (!detenido) {
+        if (atenderEventos(-1) < 0) break;
+    }
+}
+
+/**
+ * Solicita que ejecutar() termine
+ */
+void ServidorPRT7::detener() {
+    detenido = true;
+    if (despertarFd >= 0) {
+        unsigned long long uno = 1;
+        ssize_t r = write(despertarFd, &uno, sizeof(uno));
+        (void)r;
+    }
+}
+
+/**
+ * Obtiene el número de conexiones abiertas
+ */
+int ServidorPRT7::obtenerConexionesActivas() const {
+    return conexionesActivas;
+}
+
+/**
+ * Obtiene el número total de conexiones aceptadas
+ */
+unsigned long long ServidorPRT7::obtenerConexionesTotales() const {
+    return conexionesTotales;
+}
+
+/**
+ * Obtiene el número de conexiones rechazadas por falta de descriptores
+ */
+unsigned long long ServidorPRT7::obtenerConexionesRechazadas() const {
+    return conexionesRechazadas;
+}
+
+/**
+ * Obtiene el número total de tramas decodificadas
+ */
+unsigned long long ServidorPRT7::obtenerTramasProcesadas() const {
+    return tramasProcesadas;
+}
+
+/**
+ * Obtiene el número de mensajes respondidos
+ */
+unsigned long long ServidorPRT7::obtenerMensajesEnviados() const {
+    return mensajesEnviados;
+}
@@ -0,0 +1,394 @@
+/**
+ * @file SesionPRT7.cpp
+ * @brief Implementación de la sesión de decodificación PRT-7
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "SesionPRT7.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "RotorDeMapeo.h"
+#include "CascadaDeRotores.h"
+#include "ListaDeCarga.h"
+#include "ResincronizadorPRT7.h"
+#include "Trazas.h"
+#include <cstring>
+#include <cstdlib>
+
+/**
+ * Verifica si el dato de una trama LOAD es "Space" (sin importar mayúsculas)
+ */
+static bool esSpace(const char* dato) {
+    const char* palabra = "SPACE";
+    while (*dato && *palabra) {
+        char c = (*dato >= 'a' && *dato <= 'z') ? *dato - 32 : *dato;
+        if (c != *palabra) return false;
+        dato++;
+        palabra++;
+    }
+    return *dato == *palabra;
+}
+
+/**
+ * Dígitos máximos del índice de rotor en "Mk,N" (ninguna cascada llega a 10000 rotores)
+ */
+static const int MAX_DIGITOS_ROTOR = 4;
+
+/**
+ * Evento con todos los campos en 0
+ */
+static EventoPRT7 eventoVacio(EventoPRT7::Tipo tipo, int numSecuencia) {
+    EventoPRT7 evento;
+    memset(&evento, 0, sizeof(evento));
+    evento.tipo = tipo;
+    evento.numSecuencia = numSecuencia;
+    evento.codigoError = EventoPRT7::SIN_ERROR;
+    return evento;
+}
+
+/**
+ * Constructor de SesionPRT7
+ */
+SesionPRT7::SesionPRT7(int rotores, AlEvento f, void* ctx)
+    : numRotores(rotores < 1 ? 1 : rotores), rotor(nullptr), cascada(nullptr),
+      carga(nullptr), aviso(f), contexto(ctx), resincronizador(nullptr),
+      longLinea(0), esperarReinicio(false), detenida(false), numSecuencia(1),
+      tramasSecuencia(0), tramasTotales(0), errores(0) {
+    if (numRotores > 1) {
+        cascada = new CascadaDeRotores(numRotores);
+    } else {
+        rotor = new RotorDeMapeo();
+    }
+    carga = new ListaDeCarga();
+}
+
+/**
+ * Destructor de SesionPRT7
+ */
+SesionPRT7::~SesionPRT7() {
+    delete rotor;
+    delete cascada;
+    delete carga;
+}
+
+/**
+ * Descarta las tramas hasta el primer marcador de reinicio
+ */
+void SesionPRT7::setEsperarReinicio(bool activo) {
+    esperarReinicio = activo;
+    numSecuencia = activo ? 0 : 1;
+}
+
+/**
+ * Asocia un detector de palabras
+ */
+void SesionPRT7::setDetector(DetectorDePalabras* d) {
+    carga->setDetector(d);
+}
+
+/**
+ * Asocia una ventana de memoria fija
+ */
+void SesionPRT7::setVentana(VentanaDeCarga* v) {
+    carga->setVentana(v);
+}
+
+/**
+ * Asocia un mensaje empaquetado
+ */
+void SesionPRT7::setEmpaquetado(MensajeEmpaquetado* m) {
+    carga->setEmpaquetado(m);
+}
+
+/**
+ * Asocia un resincronizador
+ */
+void SesionPRT7::setResincronizador(ResincronizadorPRT7* r) {
+    resincronizador = r;
+}
+
+/**
+ * Entrega bytes recibidos y procesa cada línea completa
+ */
+std::size_t SesionPRT7::alimentar(const char* datos, std::size_t longitud) {
+    PRT7_TRAZA("SesionPRT7::alimentar");
+    
+    if (datos == nullptr) return 0;
+    detenida = false;
+    
+    for (std::size_t i = 0; i < longitud; i++) {
+        char c = datos[i];
+        if (c == '\n' || c == '\r') {
+            if (longLinea > 0) {
+                procesarLinea();
+                if (detenida) return i + 1;
+            }
+        } else if (longLinea < TAM_LINEA - 1) {
+            linea[longLinea++] = c;
+        }
+    }
+    
+    return longitud;
+}
+
+/**
+ * Procesa la línea pendiente (fin del flujo)
+ */
+void SesionPRT7::finalizar() {
+    if (longLinea > 0) {
+        procesarLinea();
+    }
+}
+
+/**
+ * Corta el alimentar() en curso
+ */
+void SesionPRT7::detener() {
+    detenida = true;
+}
+
+/**
+ * Procesa una línea completa
+ * 
+ * Solo las líneas con forma de trama (L, M, Mk seguidos de coma) se
+ * despachan; separadores y mensajes del emisor se ignoran.
+ */
+void SesionPRT7::procesarLinea() {
+    linea[longLinea] = '\0';
+    
+    if (strstr(linea, "REINICIANDO SECUENCIA") != nullptr) {
+        cerrarSecuencia();
+    } else if (((linea[0] == 'L' || linea[0] == 'l') && linea[1] == ',') ||
+               ((linea[0] == 'M' || linea[0] == 'm') &&
+                (linea[1] == ',' || (linea[1] >= '0' && linea[1] <= '9')))) {
+        // Guardar la trama cruda mientras la secuencia parcial no esté verificada
+        if (resincronizador != nullptr && !resincronizador->estaSincronizado()) {
+            resincronizador->registrarLinea(linea, static_cast<std::size_t>(longLinea));
+        }
+        
+        if (numSecuencia > 0) {
+            procesarTrama();
+            tramasSecuencia++;
+            tramasTotales++;
+        }
+    }
+    
+    longLinea = 0;
+}
+
+/**
+ * Despacha una trama LOAD o MAP sobre el rotor o la cascada
+ */
+void SesionPRT7::procesarTrama() {
+    PRT7_TRAZA("SesionPRT7::procesarTrama");
+    
+    if (linea[0] == 'L' || linea[0] == 'l') {
+        const char* dato = linea + 2;  // Saltar "L,"
+        
+        char caracter;
+        if (esSpace(dato)) {
+            caracter = ' ';
+        } else if (dato[0] != '\0') {
+            caracter = dato[0];
+        } else {
+            avisarError(EventoPRT7::LOAD_SIN_DATO, 0);
+            return;
+        }
+        
+        TramaLoad trama(caracter);
+        if (cascada != nullptr) {
+            trama.procesarEnCascada(carga, cascada);
+        } else {
+            trama.procesar(carga, rotor);
+        }
+        
+        if (aviso != nullptr) {
+            EventoPRT7 evento = eventoVacio(EventoPRT7::CARGA, numSecuencia);
+            evento.linea = linea;
+            evento.codificado = caracter;
+            evento.decodificado = trama.getResultado();
+            avisar(evento);
+        }
+    } else {
+        // "M,N" o "Mk,N" (k = índice de rotor)
+        const char* coma = linea + 1;
+        // El índice se acota en dígitos para que no desborde el int
+        int indiceRotor = 0;
+        int digitos = 0;
+        while (*coma >= '0' && *coma <= '9') {
+            if (++digitos > MAX_DIGITOS_ROTOR) break;
+            indiceRotor = indiceRotor * 10 + (*coma - '0');
+            coma++;
+        }
+        
+        if (*coma != ',') {
+            avisarError(EventoPRT7::FORMATO_MAP, indiceRotor);
+            return;
+        }
+        
+        int rotacion = atoi(coma + 1);  // Soporta negativos
+        
+        TramaMap trama(rotacion, indiceRotor);
+        if (cascada != nullptr) {
+            trama.procesarEnCascada(carga, cascada);
+        } else {
+            trama.procesar(carga, rotor);
+        }
+        
+        if (!trama.fueAplicada()) {
+            avisarError(EventoPRT7::ROTOR_INEXISTENTE, indiceRotor);
+            return;
+        }
+        
+        if (aviso != nullptr) {
+            EventoPRT7 evento = eventoVacio(EventoPRT7::MAPEO, numSecuencia);
+            evento.linea = linea;
+            evento.rotacion = rotacion;
+            evento.indiceRotor = indiceRotor;
+            evento.mapeoA = obtenerMapeo('A');
+            avisar(evento);
+        }
+    }
+}
+
+/**
+ * Entrega un ERROR_TRAMA
+ */
+void SesionPRT7::avisarError(EventoPRT7::CodigoError codigo, int indiceRotor) {
+    errores++;
+    
+    EventoPRT7 evento = eventoVacio(EventoPRT7::ERROR_TRAMA, numSecuencia);
+    evento.linea = linea;
+    evento.indiceRotor = indiceRotor;
+    evento.codigoError = codigo;
+    avisar(evento);
+}
+
+/**
+ * Cierra la secuencia actual y empieza la siguiente
+ * 
+ * El resincronizador se cierra antes de FIN_SECUENCIA para que el
+ * evento lleve el veredicto; la lista se vacía después, así que el
+ * mensaje sigue disponible durante el evento.
+ */
+void SesionPRT7::cerrarSecuencia() {
+    PRT7_TRAZA("SesionPRT7::cerrarSecuencia");
+    
+    bool hayMensaje = tramasSecuencia > 0 && numSecuencia > 0;
+    bool provisional = resincronizador != nullptr && resincronizador->esProvisional();
+    
+    int veredicto = ResincronizadorPRT7::PENDIENTE;
+    if (resincronizador != nullptr &&
+        (hayMensaje ? !resincronizador->estaSincronizado() : provisional)) {
+        // Una secuencia parcial vacía queda sincronizada desde ya
+        veredicto = resincronizador->cerrarSecuencia();
+    }
+    
+    if (hayMensaje && aviso != nullptr) {
+        EventoPRT7 evento = eventoVacio(EventoPRT7::FIN_SECUENCIA, numSecuencia);
+        evento.tramasSecuencia = tramasSecuencia;
+        evento.longitudMensaje = static_cast<std::size_t>(carga->obtenerTamanio());
+        evento.provisional = provisional;
+        evento.veredicto = veredicto;
+        avisar(evento);
+    }
+    
+    numSecuencia++;
+    tramasSecuencia = 0;
+    
+    carga->vaciar();
+    if (cascada != nullptr) {
+        // Crear antes de liberar: si falta memoria la sesión sigue válida
+        CascadaDeRotores* nueva = new CascadaDeRotores(numRotores);
+        delete cascada;
+        cascada = nueva;
+    } else {
+        rotor->reiniciar();
+    }
+    
+    avisar(eventoVacio(EventoPRT7::INICIO_SECUENCIA, numSecuencia));
+}
+
+/**
+ * Vuelve al estado inicial
+ */
+void SesionPRT7::reiniciar() {
+    longLinea = 0;
+    detenida = false;
+    numSecuencia = esperarReinicio ? 0 : 1;
+    tramasSecuencia = 0;
+    tramasTotales = 0;
+    errores = 0;
+    
+    carga->vaciar();
+    if (cascada != nullptr) {
+        // Crear antes de liberar: si falta memoria la sesión sigue válida
+        CascadaDeRotores* nueva = new CascadaDeRotores(numRotores);
+        delete cascada;
+        cascada = nueva;
+    } else {
+        rotor->reiniciar();
+    }
+    
+    if (resincronizador != nullptr) {
+        resincronizador->reiniciar();
+    }
+}
+
+/**
+ * Obtiene la lista con el mensaje de la secuencia actual
+ */
+const ListaDeCarga* SesionPRT7::obtenerCarga() const {
+    return carga;
+}
+
+/**
+ * Copia el mensaje decodificado de la secuencia actual
+ */
+std::size_t SesionPRT7::copiarMensaje(char* buffer, std::size_t capacidad) const {
+    return carga->copiarA(buffer, capacidad);
+}
+
+/**
+ * Obtiene cómo se decodifica un carácter con el rotor actual
+ */
+char SesionPRT7::obtenerMapeo(char c) const {
+    return (cascada != nullptr) ? cascada->getMapeo(c) : rotor->getMapeo(c);
+}
+
+/**
+ * Obtiene el número de rotores
+ */
+int SesionPRT7::obtenerNumRotores() const {
+    return numRotores;
+}
+
+/**
+ * Obtiene el número de la secuencia actual
+ */
+int SesionPRT7::obtenerNumSecuencia() const {
+    return numSecuencia;
+}
+
+/**
+ * Obtiene las tramas recibidas en la secuencia actual
+ */
+int SesionPRT7::obtenerTramasSecuencia() const {
+    return tramasSecuencia;
+}
+
+/**
+ * Obtiene las tramas procesadas desde el inicio
+ */
+unsigned long long SesionPRT7::obtenerTramasTotales() const {
+    return tramasTotales;
+}
+
+/**
+ * Obtiene el número de tramas mal formadas
+ */
+int SesionPRT7::obtenerErrores() const {
+    return errores;
+}
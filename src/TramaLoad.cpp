@@ -9,12 +9,13 @@
 #include "TramaLoad.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
-#include <iostream>
+#include "CascadaDeRotores.h"
+#include "Trazas.h"
 
 /**
  * Constructor de TramaLoad
  */
-TramaLoad::TramaLoad(char c) : dato(c) {
+TramaLoad::TramaLoad(char c) : dato(c), resultado('\0') {
 }
 
 /**
@@ -30,17 +31,31 @@ TramaLoad::~TramaLoad() {
  */
 void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     if (carga == nullptr || rotor == nullptr) return;
+    PRT7_TRAZA("TramaLoad::procesar");
     
     // Decodificar el carácter usando el rotor
     char decodificado = rotor->getMapeo(dato);
     
     // Agregar ambos caracteres (codificado y decodificado) a la lista
     carga->insertarAlFinal(dato, decodificado);
+    resultado = decodificado;
+}
+
+/**
+ * Procesa la trama LOAD sobre una cascada de rotores
+ * Una sola consulta a la tabla compuesta, sin importar el número de rotores
+ */
+void TramaLoad::procesarEnCascada(ListaDeCarga* carga, CascadaDeRotores* cascada) {
+    if (carga == nullptr || cascada == nullptr) return;
     
-    // Mostrar en formato: Fragmento 'X' decodificado como 'Y' -> Codificado: 'X'
-    std::cout << "Trama recibida: [L," << dato << "] -> Procesando... -> Fragmento '" 
-              << dato << "' decodificado como '" << decodificado << "'. ";
-    
-    // Mostrar mensaje parcial acumulado
-    carga->imprimirMensajeParcial();
+    char decodificado = cascada->getMapeo(dato);
+    carga->insertarAlFinal(dato, decodificado);
+    resultado = decodificado;
+}
+
+/**
+ * Obtiene el carácter decodificado por el último procesamiento
+ */
+char TramaLoad::getResultado() const {
+    return resultado;
 }
@@ -9,12 +9,13 @@
 #include "TramaMap.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
-#include <iostream>
+#include "CascadaDeRotores.h"
+#include "Trazas.h"
 
 /**
  * Constructor de TramaMap
  */
-TramaMap::TramaMap(int n) : rotacion(n) {
+TramaMap::TramaMap(int n, int indice) : rotacion(n), indiceRotor(indice), aplicada(false) {
 }
 
 /**
@@ -29,14 +30,33 @@ TramaMap::~TramaMap() {
  * Aplica la rotación al rotor de mapeo
  */
 void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    (void)carga;  // La rotación no toca la lista
     if (rotor == nullptr) return;
+    PRT7_TRAZA("TramaMap::procesar");
+    
+    // Un solo rotor: solo existe el índice 0
+    aplicada = (indiceRotor == 0);
+    if (!aplicada) return;
     
     // Rotar el rotor
     rotor->rotar(rotacion);
+}
+
+/**
+ * Procesa la trama MAP sobre una cascada de rotores
+ * Rota el rotor indicado; la tabla compuesta se recalcula en la siguiente consulta
+ */
+void TramaMap::procesarEnCascada(ListaDeCarga* carga, CascadaDeRotores* cascada) {
+    (void)carga;  // La rotación no toca la lista
     
-    std::cout << std::endl;
-    std::cout << "Trama recibida: [M," << rotacion << "] -> Procesando... -> ROTANDO ROTOR ";
-    if (rotacion >= 0) std::cout << "+";
-    std::cout << rotacion << ". (Ahora 'A' se mapea a '" << rotor->getMapeo('A') << "')" << std::endl;
-    std::cout << std::endl;
+    if (cascada == nullptr) return;
+    
+    aplicada = cascada->rotar(indiceRotor, rotacion);
+}
+
+/**
+ * Verifica si el último procesamiento aplicó la rotación
+ */
+bool TramaMap::fueAplicada() const {
+    return aplicada;
 }
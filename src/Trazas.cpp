@@ -0,0 +1,218 @@
+/**
+ * @file Trazas.cpp
+ * @brief Implementación de los puntos de traza y el volcado JSON de Chrome
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "Trazas.h"
+
+#ifdef PRT7_TRAZAS
+
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <ctime>
+#include <unistd.h>
+#include <fcntl.h>
+
+/**
+ * Eventos que guarda cada hilo (los más viejos se sobrescriben)
+ */
+static const unsigned long long CAPACIDAD_ANILLO = 65536;
+
+/**
+ * @struct EventoTraza
+ * @brief Evento completo (fase "X" en el formato de Chrome)
+ */
+struct EventoTraza {
+    const char* nombre;          ///< Nombre del evento
+    unsigned long long inicioNs; ///< Inicio (reloj monotónico)
+    unsigned long long duracionNs; ///< Duración
+};
+
+/**
+ * @struct AnilloTrazas
+ * @brief Buffer circular de eventos de un hilo
+ * 
+ * Solo lo escribe su hilo; 'escritos' se publica después de cada evento.
+ */
+struct AnilloTrazas {
+    EventoTraza eventos[CAPACIDAD_ANILLO];     ///< Eventos
+    std::atomic<unsigned long long> escritos;  ///< Total de eventos registrados
+    int idHilo;                                ///< Identificador para el JSON
+    AnilloTrazas* siguiente;                   ///< Siguiente anillo registrado
+};
+
+static std::atomic<AnilloTrazas*> anillos(nullptr);  ///< Lista de anillos de todos los hilos
+static std::mutex mutexRegistro;                      ///< Protege el registro de anillos
+static int siguienteIdHilo = 1;                       ///< Próximo id de hilo
+static thread_local AnilloTrazas* anilloDelHilo = nullptr;  ///< Anillo del hilo actual
+static char rutaVolcado[256] = "prt7_traza.json";     ///< Archivo de salida
+
+/**
+ * Tiempo actual del reloj monotónico en nanosegundos
+ */
+static unsigned long long ahoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Volcado al terminar el programa
+ */
+static void volcarAlSalir() {
+    volcarTrazas(rutaVolcado);
+}
+
+/**
+ * Volcado a petición (SIGUSR2)
+ */
+static void volcarPorSenal(int) {
+    volcarTrazas(rutaVolcado);
+}
+
+/**
+ * Crea y registra el anillo del hilo actual
+ */
+static AnilloTrazas* registrarAnillo() {
+    AnilloTrazas* anillo = new AnilloTrazas();
+    anillo->escritos.store(0, std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> guardia(mutexRegistro);
+    
+    if (siguienteIdHilo == 1) {
+        // Primer anillo: configurar el volcado
+        const char* ruta = getenv("PRT7_TRAZA_ARCHIVO");
+        if (ruta != nullptr && strlen(ruta) < sizeof(rutaVolcado)) {
+            strcpy(rutaVolcado, ruta);
+        }
+        atexit(volcarAlSalir);
+        signal(SIGUSR2, volcarPorSenal);
+    }
+    
+    anillo->idHilo = siguienteIdHilo++;
+    anillo->siguiente = anillos.load(std::memory_order_relaxed);
+    anillos.store(anillo, std::memory_order_release);
+    return anillo;
+}
+
+/**
+ * Constructor de PuntoDeTraza
+ */
+PuntoDeTraza::PuntoDeTraza(const char* n) : nombre(n), inicioNs(ahoraNs()) {
+}
+
+/**
+ * Destructor de PuntoDeTraza
+ */
+PuntoDeTraza::~PuntoDeTraza() {
+    unsigned long long finNs = ahoraNs();
+    
+    if (anilloDelHilo == nullptr) {
+        anilloDelHilo = registrarAnillo();
+    }
+    
+    unsigned long long i = anilloDelHilo->escritos.load(std::memory_order_relaxed);
+    EventoTraza& e = anilloDelHilo->eventos[i % CAPACIDAD_ANILLO];
+    e.nombre = nombre;
+    e.inicioNs = inicioNs;
+    e.duracionNs = finNs - inicioNs;
+    anilloDelHilo->escritos.store(i + 1, std::memory_order_release);
+}
+
+/**
+ * Buffer de escritura para el volcado (sin memoria dinámica)
+ */
+struct SalidaVolcado {
+    int fd;          ///< Archivo destino
+    char datos[8192];///< Buffer
+    int longitud;    ///< Bytes en el buffer
+};
+
+static void volcarBuffer(SalidaVolcado& s) {
+    int escritos = 0;
+    while (escritos < s.longitud) {
+        ssize_t n = write(s.fd, s.datos + escritos, s.longitud - escritos);
+        if (n <= 0) break;
+        escritos += static_cast<int>(n);
+    }
+    s.longitud = 0;
+}
+
+static void agregarTexto(SalidaVolcado& s, const char* texto) {
+    while (*texto) {
+        if (s.longitud == static_cast<int>(sizeof(s.datos))) volcarBuffer(s);
+        s.datos[s.longitud++] = *texto++;
+    }
+}
+
+static void agregarEntero(SalidaVolcado& s, unsigned long long valor) {
+    char digitos[24];
+    int n = 0;
+    do {
+        digitos[n++] = static_cast<char>('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    
+    char texto[24];
+    for (int i = 0; i < n; i++) texto[i] = digitos[n - 1 - i];
+    texto[n] = '\0';
+    agregarTexto(s, texto);
+}
+
+/**
+ * Escribe nanosegundos como microsegundos con tres decimales
+ */
+static void agregarMicrosegundos(SalidaVolcado& s, unsigned long long ns) {
+    agregarEntero(s, ns / 1000);
+    char decimales[5] = { '.', static_cast<char>('0' + (ns / 100) % 10),
+                          static_cast<char>('0' + (ns / 10) % 10),
+                          static_cast<char>('0' + ns % 10), '\0' };
+    agregarTexto(s, decimales);
+}
+
+/**
+ * Vuelca todos los eventos como JSON de Chrome
+ */
+bool volcarTrazas(const char* ruta) {
+    SalidaVolcado s;
+    s.fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    s.longitud = 0;
+    if (s.fd < 0) return false;
+    
+    agregarTexto(s, "{\"traceEvents\":[\n");
+    bool primero = true;
+    
+    for (AnilloTrazas* a = anillos.load(std::memory_order_acquire); a != nullptr; a = a->siguiente) {
+        unsigned long long total = a->escritos.load(std::memory_order_acquire);
+        unsigned long long desde = (total > CAPACIDAD_ANILLO) ? total - CAPACIDAD_ANILLO : 0;
+        
+        for (unsigned long long i = desde; i < total; i++) {
+            const EventoTraza& e = a->eventos[i % CAPACIDAD_ANILLO];
+            
+            agregarTexto(s, primero ? "" : ",\n");
+            primero = false;
+            agregarTexto(s, "{\"name\":\"");
+            agregarTexto(s, e.nombre);
+            agregarTexto(s, "\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+            agregarEntero(s, static_cast<unsigned long long>(a->idHilo));
+            agregarTexto(s, ",\"ts\":");
+            agregarMicrosegundos(s, e.inicioNs);
+            agregarTexto(s, ",\"dur\":");
+            agregarMicrosegundos(s, e.duracionNs);
+            agregarTexto(s, "}");
+        }
+    }
+    
+    agregarTexto(s, "\n]}\n");
+    volcarBuffer(s);
+    close(s.fd);
+    return true;
+}
+
+#endif // PRT7_TRAZAS
@@ -0,0 +1,236 @@
+/**
+ * @file VentanaDeCarga.cpp
+ * @brief Implementación de la ventana deslizante con derrame a disco
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "VentanaDeCarga.h"
+#include "Trazas.h"
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Constructor de VentanaDeCarga
+ */
+VentanaDeCarga::VentanaDeCarga(std::size_t capacidadVentana, const char* rutaSegmento)
+    : anillo(nullptr), capacidad(0), inicio(0), cantidad(0), fdSegmento(-1),
+      longSegmento(0), inicioSecuencia(0), derramados(0), descartados(0),
+      mapa(nullptr), longMapa(0) {
+    // Redondear hacia arriba a bloques completos (mínimo un bloque)
+    std::size_t bloques = (capacidadVentana + TAM_BLOQUE - 1) / TAM_BLOQUE;
+    if (bloques == 0) bloques = 1;
+    capacidad = bloques * TAM_BLOQUE;
+    anillo = new char[capacidad];
+    
+    if (rutaSegmento != nullptr) {
+        fdSegmento = open(rutaSegmento, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fdSegmento >= 0) {
+            struct stat info;
+            if (fstat(fdSegmento, &info) == 0) {
+                longSegmento = static_cast<std::size_t>(info.st_size);
+            }
+            inicioSecuencia = longSegmento;
+        }
+    }
+}
+
+/**
+ * Destructor de VentanaDeCarga
+ */
+VentanaDeCarga::~VentanaDeCarga() {
+    desmapear();
+    if (fdSegmento >= 0) {
+        close(fdSegmento);
+    }
+    delete[] anillo;
+}
+
+/**
+ * Verifica si hay segmento en disco
+ */
+bool VentanaDeCarga::tieneSegmento() const {
+    return fdSegmento >= 0;
+}
+
+/**
+ * Obtiene la capacidad del anillo
+ */
+std::size_t VentanaDeCarga::obtenerCapacidad() const {
+    return capacidad;
+}
+
+/**
+ * Escribe el bloque más antiguo al segmento y lo libera del anillo
+ * 
+ * Si la escritura falla se deja de usar el disco: lo que ya está en el
+ * segmento sigue siendo un prefijo contiguo de la secuencia.
+ */
+void VentanaDeCarga::derramarBloque() {
+    PRT7_TRAZA("VentanaDeCarga::derramarBloque");
+    
+    if (fdSegmento >= 0) {
+        const char* p = anillo + inicio;
+        std::size_t restante = TAM_BLOQUE;
+        while (restante > 0) {
+            ssize_t n = write(fdSegmento, p, restante);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            p += n;
+            restante -= static_cast<std::size_t>(n);
+        }
+        
+        longSegmento += TAM_BLOQUE - restante;
+        if (restante > 0) {
+            descartados += restante;
+            close(fdSegmento);
+            fdSegmento = -1;
+        }
+    } else {
+        descartados += TAM_BLOQUE;
+    }
+    
+    inicio += TAM_BLOQUE;
+    if (inicio == capacidad) inicio = 0;
+    cantidad -= TAM_BLOQUE;
+    derramados += TAM_BLOQUE;
+}
+
+/**
+ * Comienza una nueva secuencia
+ */
+void VentanaDeCarga::vaciar() {
+    inicio = 0;
+    cantidad = 0;
+    derramados = 0;
+    inicioSecuencia = longSegmento;
+}
+
+/**
+ * Obtiene el número total de caracteres de la secuencia actual
+ */
+std::size_t VentanaDeCarga::obtenerTamanio() const {
+    return derramados + cantidad;
+}
+
+/**
+ * Obtiene el número de caracteres en memoria
+ */
+std::size_t VentanaDeCarga::obtenerEnMemoria() const {
+    return cantidad;
+}
+
+/**
+ * Obtiene el número de caracteres de la secuencia en disco
+ */
+std::size_t VentanaDeCarga::obtenerEnDisco() const {
+    return longSegmento - inicioSecuencia;
+}
+
+/**
+ * Obtiene el número de caracteres perdidos
+ */
+std::size_t VentanaDeCarga::obtenerDescartados() const {
+    return descartados;
+}
+
+/**
+ * Copia el contenido del anillo en orden (dos tramos como máximo)
+ */
+std::size_t VentanaDeCarga::copiarVentana(char* buffer, std::size_t capacidadBuffer) const {
+    if (buffer == nullptr || capacidadBuffer == 0) return 0;
+    
+    std::size_t n = cantidad;
+    if (n > capacidadBuffer - 1) n = capacidadBuffer - 1;
+    
+    std::size_t primero = capacidad - inicio;
+    if (primero > n) primero = n;
+    memcpy(buffer, anillo + inicio, primero);
+    memcpy(buffer + primero, anillo, n - primero);
+    buffer[n] = '\0';
+    
+    return n;
+}
+
+/**
+ * Libera el mapeo actual
+ */
+void VentanaDeCarga::desmapear() const {
+    if (mapa != nullptr) {
+        munmap(const_cast<char*>(mapa), longMapa);
+        mapa = nullptr;
+        longMapa = 0;
+    }
+}
+
+/**
+ * Mapea el segmento completo (solo lectura)
+ */
+const char* VentanaDeCarga::mapearSegmento(std::size_t* longitud) const {
+    if (longitud != nullptr) *longitud = 0;
+    if (longSegmento == 0) return nullptr;
+    
+    // Si el segmento se cerró por un error de escritura ya no crece:
+    // se conserva el último mapeo válido
+    if ((mapa == nullptr || longMapa != longSegmento) && fdSegmento >= 0) {
+        desmapear();
+        
+        void* p = mmap(nullptr, longSegmento, PROT_READ, MAP_SHARED, fdSegmento, 0);
+        if (p == MAP_FAILED) return nullptr;
+        mapa = static_cast<const char*>(p);
+        longMapa = longSegmento;
+    }
+    
+    if (longitud != nullptr) *longitud = longMapa;
+    return mapa;
+}
+
+/**
+ * Lee caracteres de la secuencia actual (disco y después anillo)
+ */
+std::size_t VentanaDeCarga::leer(std::size_t posicion, char* destino, std::size_t n) const {
+    if (destino == nullptr) return 0;
+    
+    std::size_t leidos = 0;
+    
+    // Parte derramada: a través del mapeo del segmento
+    if (posicion < derramados) {
+        std::size_t enDisco = obtenerEnDisco();
+        if (posicion >= enDisco) return 0;  // se perdió al derramar
+        
+        std::size_t longitud = 0;
+        const char* segmento = mapearSegmento(&longitud);
+        if (segmento == nullptr || inicioSecuencia + posicion >= longitud) return 0;
+        
+        std::size_t k = longitud - inicioSecuencia - posicion;
+        if (k > enDisco - posicion) k = enDisco - posicion;
+        if (k > n) k = n;
+        memcpy(destino, segmento + inicioSecuencia + posicion, k);
+        leidos = k;
+        posicion += k;
+        
+        if (posicion < derramados) return leidos;
+    }
+    
+    // Parte en memoria: índice relativo al carácter más antiguo del anillo
+    std::size_t relativo = posicion - derramados;
+    while (leidos < n && relativo < cantidad) {
+        std::size_t idx = inicio + relativo;
+        if (idx >= capacidad) idx -= capacidad;
+        
+        std::size_t k = capacidad - idx;
+        if (k > cantidad - relativo) k = cantidad - relativo;
+        if (k > n - leidos) k = n - leidos;
+        
+        memcpy(destino + leidos, anillo + idx, k);
+        leidos += k;
+        relativo += k;
+    }
+    
+    return leidos;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file prt7.cpp
+ * @brief Implementación de la interfaz en C de libprt7
+ * 
+ * @author Arturo
+ * @date 2025-11-06
+ */
+
+#include "prt7.h"
+#include "SesionPRT7.h"
+#include <new>
+
+#ifndef PRT7_VERSION
+#define PRT7_VERSION "1.1.0"
+#endif
+
+/**
+ * Sesión de C: la sesión de C++ más la función de eventos del usuario
+ */
+struct prt7_sesion {
+    SesionPRT7* sesion;        ///< Sesión decodificadora
+    prt7_al_evento alEvento;   ///< Función de eventos del usuario
+    void* contexto;            ///< Contexto del usuario
+};
+
+/**
+ * Traduce un EventoPRT7 a prt7_evento y lo entrega al usuario
+ */
+static void reenviarEvento(const EventoPRT7* evento, void* contexto) {
+    prt7_sesion* s = static_cast<prt7_sesion*>(contexto);
+    
+    prt7_evento e;
+    e.tipo = static_cast<int>(evento->tipo);
+    e.linea = evento->linea;
+    e.codificado = evento->codificado;
+    e.decodificado = evento->decodificado;
+    e.rotacion = evento->rotacion;
+    e.indice_rotor = evento->indiceRotor;
+    e.mapeo_a = evento->mapeoA;
+    e.num_secuencia = evento->numSecuencia;
+    e.tramas_secuencia = evento->tramasSecuencia;
+    e.longitud_mensaje = evento->longitudMensaje;
+    e.provisional = evento->provisional ? 1 : 0;
+    e.veredicto = evento->veredicto;
+    e.codigo_error = static_cast<int>(evento->codigoError);
+    
+    s->alEvento(&e, s->contexto);
+}
+
+/**
+ * Versión de la biblioteca
+ */
+const char* prt7_version(void) {
+    return PRT7_VERSION;
+}
+
+/**
+ * Crea una sesión
+ */
+prt7_sesion* prt7_crear(int num_rotores, prt7_al_evento al_evento, void* contexto,
+                        int esperar_reinicio) {
+    prt7_sesion* s = new (std::nothrow) prt7_sesion;
+    if (s == nullptr) return nullptr;
+    
+    s->alEvento = al_evento;
+    s->contexto = contexto;
+    try {
+        s->sesion = new SesionPRT7(num_rotores, al_evento != nullptr ? reenviarEvento : nullptr, s);
+    } catch (...) {
+        delete s;
+        return nullptr;
+    }
+    s->sesion->setEsperarReinicio(esperar_reinicio != 0);
+    
+    return s;
+}
+
+/**
+ * Destruye una sesión
+ */
+void prt7_destruir(prt7_sesion* sesion) {
+    if (sesion == nullptr) return;
+    delete sesion->sesion;
+    delete sesion;
+}
+
+/**
+ * Entrega bytes recibidos
+ */
+size_t prt7_alimentar(prt7_sesion* sesion, const char* datos, size_t longitud) {
+    try {
+        return sesion->sesion->alimentar(datos, longitud);
+    } catch (...) {
+        return PRT7_ERROR;
+    }
+}
+
+/**
+ * Procesa la línea pendiente
+ */
+int prt7_finalizar(prt7_sesion* sesion) {
+    try {
+        sesion->sesion->finalizar();
+    } catch (...) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Corta el prt7_alimentar en curso
+ */
+void prt7_detener(prt7_sesion* sesion) {
+    sesion->sesion->detener();
+}
+
+/**
+ * Vuelve la sesión a su estado inicial
+ */
+int prt7_reiniciar(prt7_sesion* sesion) {
+    try {
+        sesion->sesion->reiniciar();
+    } catch (...) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Obtiene el número de la secuencia actual
+ */
+int prt7_num_secuencia(const prt7_sesion* sesion) {
+    return sesion->sesion->obtenerNumSecuencia();
+}
+
+/**
+ * Obtiene las tramas de la secuencia actual
+ */
+int prt7_tramas_secuencia(const prt7_sesion* sesion) {
+    return sesion->sesion->obtenerTramasSecuencia();
+}
+
+/**
+ * Obtiene las tramas procesadas desde el inicio
+ */
+unsigned long long prt7_tramas_totales(const prt7_sesion* sesion) {
+    return sesion->sesion->obtenerTramasTotales();
+}
+
+/**
+ * Obtiene el número de tramas mal formadas
+ */
+int prt7_errores(const prt7_sesion* sesion) {
+    return sesion->sesion->obtenerErrores();
+}
+
+/**
+ * Obtiene cómo se decodifica un carácter con el rotor actual
+ */
+char prt7_mapeo(const prt7_sesion* sesion, char c) {
+    return sesion->sesion->obtenerMapeo(c);
+}
+
+/**
+ * Copia el mensaje de la secuencia actual
+ */
+size_t prt7_copiar_mensaje(const prt7_sesion* sesion, char* buffer, size_t capacidad) {
+    try {
+        return sesion->sesion->copiarMensaje(buffer, capacidad);
+    } catch (...) {
+        if (buffer != nullptr && capacidad > 0) buffer[0] = '\0';
+        return 0;
+    }
+}